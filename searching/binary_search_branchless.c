@@ -0,0 +1,213 @@
+/**
+ * @file binary_search_branchless.c
+ * @brief Branchless binary search (lower bound / upper bound) with software prefetching.
+ *
+ * @details
+ * The classic binary search in binary_search_simple.c decides at every level whether to go
+ * left or right with a conditional branch. For a random target that branch is unpredictable,
+ * and once the array is larger than the L2 cache every level also waits for a cache miss that
+ * cannot start before the previous comparison is known. This version removes both stalls:
+ * - **No branches on the data**: the search keeps a base pointer and a length. Each step
+ *   compares one element and advances the base by half the length times the result of the
+ *   comparison, which compiles to a conditional move or an add instead of a jump. The loop
+ *   runs exactly ceil(log2 n) times whatever the data, so its own branch always predicts.
+ * - **Prefetching**: the element examined two steps later is one of four candidates, known
+ *   before the current comparison completes. For arrays larger than
+ *   BINARY_SEARCH_PREFETCH_MIN elements all four are prefetched, so the memory latency of the
+ *   next levels overlaps with the current one instead of adding up.
+ *
+ * search_lower_bound() and search_upper_bound() follow the C++ std::lower_bound and
+ * std::upper_bound conventions, so duplicates, insertion points and ranges of equal keys can
+ * be found as well as exact matches.
+ *
+ * @section Performance
+ * - Time Complexity: O(log n), with a fixed number of iterations for a given n.
+ * - Space Complexity: O(1).
+ *
+ * @reference
+ * - Paul-Virak Khuong and Pat Morin, "Array Layouts for Comparison-Based Searching", 2017.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#include "search.h"
+#include "search_internal.h"
+
+/** Arrays of at least this many elements (64 KB) prefetch two levels ahead. */
+#define BINARY_SEARCH_PREFETCH_MIN (1 << 14)
+
+/**
+ * @brief Shared body of the lower and upper bound searches.
+ *
+ * Inlined with constant flags, so each caller gets its own loop without the tests on them.
+ *
+ * @param or_equal Nonzero to skip over elements equal to target (upper bound).
+ * @param prefetch Nonzero to prefetch the candidates two levels ahead.
+ */
+static inline int branchless_bound(const int *arr, int n, int target, int or_equal,
+                                   int prefetch) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    const int *base = arr;
+    int len = n;
+    while (len > 1) {
+        int half = len / 2;
+        if (prefetch) {
+            // The next two steps probe base + {0, half} + {0, half1} + half2
+            int half1 = (len - half) / 2;
+            int half2 = (len - half - half1) / 2;
+            SEARCH_PREFETCH(base + half2);
+            SEARCH_PREFETCH(base + half1 + half2);
+            SEARCH_PREFETCH(base + half + half2);
+            SEARCH_PREFETCH(base + half + half1 + half2);
+        }
+        int below = or_equal ? base[half] <= target : base[half] < target;
+        base += below * half;
+        len -= half;
+    }
+    return (int)(base - arr) + (or_equal ? *base <= target : *base < target);
+}
+
+/**
+ * @brief Returns the index of the first element not less than target.
+ *
+ * @param arr Array sorted in ascending order.
+ * @param n The number of elements in the array.
+ * @param target The value to look for.
+ * @return The index in [0, n]; n if every element is less than target.
+ */
+int search_lower_bound(const int *arr, int n, int target) {
+    if (n >= BINARY_SEARCH_PREFETCH_MIN) {
+        return branchless_bound(arr, n, target, 0, 1);
+    }
+    return branchless_bound(arr, n, target, 0, 0);
+}
+
+/**
+ * @brief Returns the index of the first element greater than target.
+ *
+ * @param arr Array sorted in ascending order.
+ * @param n The number of elements in the array.
+ * @param target The value to look for.
+ * @return The index in [0, n]; n if no element is greater than target.
+ */
+int search_upper_bound(const int *arr, int n, int target) {
+    if (n >= BINARY_SEARCH_PREFETCH_MIN) {
+        return branchless_bound(arr, n, target, 1, 1);
+    }
+    return branchless_bound(arr, n, target, 1, 0);
+}
+
+/**
+ * @brief Finds target in a sorted array.
+ *
+ * @param arr Array sorted in ascending order.
+ * @param n The number of elements in the array.
+ * @param target The value to look for.
+ * @return Index of the first element equal to target, otherwise -1.
+ */
+int binary_search_branchless(const int *arr, int n, int target) {
+    int i = search_lower_bound(arr, n, target);
+    return i < n && arr[i] == target ? i : -1;
+}
+
+#ifdef SEARCH_DEMO
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int random_int(void) {
+    return (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+}
+
+/**
+ * @brief Driver code to demonstrate the branchless binary search.
+ *
+ * Checks both bounds against a linear scan on many small arrays with duplicates, then times
+ * random lookups in an array much larger than the caches against binarySearch().
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {2, 4, 4, 4, 8, 10};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    printf("lower_bound(4) = %d, upper_bound(4) = %d\n", search_lower_bound(arr1, n1, 4),
+           search_upper_bound(arr1, n1, 4));
+    assert(search_lower_bound(arr1, n1, 4) == 1);
+    assert(search_upper_bound(arr1, n1, 4) == 4);
+    assert(search_lower_bound(arr1, n1, 1) == 0);
+    assert(search_lower_bound(arr1, n1, 11) == n1);
+    assert(binary_search_branchless(arr1, n1, 8) == 4);
+    assert(binary_search_branchless(arr1, n1, 5) == -1);
+    assert(search_lower_bound(NULL, 0, 7) == 0);
+    assert(binary_search_branchless(NULL, 0, 7) == -1);
+
+    int extremes[] = {INT_MIN, INT_MIN, 0, INT_MAX};
+    assert(search_lower_bound(extremes, 4, INT_MIN) == 0);
+    assert(search_upper_bound(extremes, 4, INT_MIN) == 2);
+    assert(search_upper_bound(extremes, 4, INT_MAX) == 4);
+
+    // Every target around every small sorted array with duplicates
+    enum { MAX_N = 200 };
+    int arr[MAX_N];
+    srand(71);
+    for (int n = 0; n <= MAX_N; n++) {
+        int value = 0;
+        for (int i = 0; i < n; i++) {
+            value += rand() % 3;
+            arr[i] = value;
+        }
+        for (int target = -1; target <= value + 1; target++) {
+            int lower = 0, upper = 0;
+            while (lower < n && arr[lower] < target)
+                lower++;
+            while (upper < n && arr[upper] <= target)
+                upper++;
+            assert(search_lower_bound(arr, n, target) == lower);
+            assert(search_upper_bound(arr, n, target) == upper);
+            assert(binary_search_branchless(arr, n, target) == (lower < upper ? lower : -1));
+        }
+    }
+
+    // Random point lookups in a 64 MB array of sorted IDs
+    enum { N = 1 << 24, LOOKUPS = 1 << 21 };
+    int *ids = malloc(N * sizeof(int));
+    int *targets = malloc(LOOKUPS * sizeof(int));
+    assert(ids != NULL && targets != NULL);
+    for (int i = 0; i < N; i++) {
+        ids[i] = 2 * i;
+    }
+    for (int i = 0; i < LOOKUPS; i++) {
+        targets[i] = (int)((unsigned)random_int() % (2u * N));
+    }
+
+    long long found_classic = 0, found_branchless = 0;
+    clock_t start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        found_classic += binarySearch(ids, 0, N - 1, targets[i]) >= 0;
+    }
+    double t_classic = seconds_since(start);
+    start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        found_branchless += binary_search_branchless(ids, N, targets[i]) >= 0;
+    }
+    double t_branchless = seconds_since(start);
+    assert(found_classic == found_branchless);
+    printf("%d lookups in %d ints: binarySearch %.3fs, branchless %.3fs\n", LOOKUPS, N,
+           t_classic, t_branchless);
+    free(ids);
+    free(targets);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SEARCH_DEMO */
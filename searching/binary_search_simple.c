@@ -24,6 +24,8 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Binary search function.
  * @param arr[] Sorted array to search.
@@ -70,6 +72,7 @@ int binarySearch(int arr[], int left, int right, int target) {
     return -1;  // Target not found in the array
 } */
 
+#ifdef SEARCH_DEMO
 /**
  * @brief Main Function
  * @return 0 on success.
@@ -100,3 +103,4 @@ int main() {
 
     return 0;
 }
+#endif /* SEARCH_DEMO */
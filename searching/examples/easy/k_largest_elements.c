@@ -6,13 +6,25 @@
  * 
  * @details 
  * The approaches include:
- * - **Sorting**: Sorts the array in descending order and picks the first k elements.
+ * - **Streaming Min-Heap**: Keeps the k largest elements seen so far in a min-heap of size k.
  * - **Binary Search**: Uses binary search to find the k largest elements.
  * 
  * @complexity
- * - **Sorting**: O(n log n) time complexity for sorting.
+ * - **Streaming Min-Heap**: O(n log k) time in the worst case and O(k) extra space; the input
+ *   can arrive in chunks and is neither sorted nor stored.
  * - **Binary Search**: O(n log(max - min)) time complexity.
  * 
+ * @approach1 Streaming Min-Heap Explanation:
+ * - The root of the min-heap is the smallest of the k largest elements seen so far.
+ * - While the heap holds fewer than k elements, every element is inserted.
+ * - After that, an element is only kept if it is larger than the root: it replaces the root
+ *   using Floyd's bottom-up sift, which moves the hole at the root down to a leaf along the
+ *   smaller children and then sifts the newcomer up from there. Most elements of a long
+ *   stream fail the single comparison with the root.
+ * - The heap is `top_k_t` from `top_k.h` in `sorting/`, which also merges per-thread results.
+ *   Build with `make libsort`, then from the repository root
+ *   `gcc -Isorting searching/examples/easy/k_largest_elements.c build/libsort.a -lm -pthread`.
+ * 
  * @approach2 Binary Search Explanation:
  * - Find the minimum (`low`) and maximum (`high`) elements in the array.
  * - Perform binary search to find the `k` largest elements:
@@ -30,41 +42,45 @@
 #include <stdlib.h>
 #include <limits.h>
 
-/** 
- * @brief Comparator function for qsort.
- * 
- * @param a Pointer to the first element.
- * @param b Pointer to the second element.
- * @return The difference between the two elements.
- */
-/*
-int compare(const void * a, const void * b)
-{
-    return (*(int *)b - *(int *)a);
-}
-*/
+#include "top_k.h"
 
 /** 
- * @brief Finds the k largest elements in an array using the Sorting approach.
+ * @brief Finds the k largest elements in an array using a streaming min-heap.
+ * 
+ * The array is fed to the heap in chunks, as a stream that never fits in memory would be.
+ * The heap is the top_k_t accumulator of libsort.
  * 
  * @param arr Array of integers.
  * @param n Number of elements in the array.
  * @param k Number of largest elements to find.
  */
-/*
-void kLargestElements_Sorting(int arr[], int n, int k)
+void kLargestElements_MinHeap(int arr[], int n, int k)
 {
-    // Sort the array in descending order
-    qsort(arr, n, sizeof(arr[0]), compare);
+    const int chunk_size = 4;
+    top_k_t *tk = top_k_create(k);
+    int *largest = malloc(k * sizeof(int));
+
+    if (tk == NULL || largest == NULL) {
+        top_k_destroy(tk);
+        free(largest);
+        return;
+    }
+    for (int i = 0; i < n; i += chunk_size) {
+        int len = n - i < chunk_size ? n - i : chunk_size;
+        top_k_push(tk, arr + i, len);
+    }
+
+    // Largest first
+    int count = top_k_result(tk, largest);
+
     printf("The %d largest elements in the array are: ", k);
-    // Print the first k elements
-    for (int i = 0; i < k; i++)
-    {
-        printf("%d ", arr[i]);
+    for (int i = 0; i < count; i++) {
+        printf("%d ", largest[i]);
     }
     printf("\n");
+    top_k_destroy(tk);
+    free(largest);
 }
-*/
 
 /** 
  * @brief Finds the k largest elements in an array using the Binary Search approach.
@@ -114,9 +130,9 @@ void kLargestElements_BinarySearch(int arr[], int n, int k)
 }
 
 /**
- * @brief Driver code to demonstrate the kLargestElements_BinarySearch function.
+ * @brief Driver code to demonstrate the kLargestElements_MinHeap and kLargestElements_BinarySearch functions.
  * 
- * This function creates multiple test cases and calls the kLargestElements_BinarySearch function to find and print
+ * This function creates multiple test cases and calls both functions to find and print
  * the k largest elements in each array.
  * 
  * @return 0 on successful execution.
@@ -127,7 +143,8 @@ int main()
     int n = sizeof(arr) / sizeof(arr[0]);
     int k = 3; // Number of largest elements to find
 
-    kLargestElements_BinarySearch(arr, n, k); // Call function to find k largest elements
+    kLargestElements_MinHeap(arr, n, k); // Call function to find k largest elements
+    kLargestElements_BinarySearch(arr, n, k);
 
     // Output: 50, 30, 23
 
@@ -136,7 +153,8 @@ int main()
     int n1 = sizeof(arr1) / sizeof(arr1[0]);
     int k1 = 5; // Number of largest elements to find
 
-    kLargestElements_BinarySearch(arr1, n1, k1); // Call function to find k largest elements
+    kLargestElements_MinHeap(arr1, n1, k1); // Call function to find k largest elements
+    kLargestElements_BinarySearch(arr1, n1, k1);
 
     return 0; // Return 0 to indicate successful execution
 }
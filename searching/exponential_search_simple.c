@@ -40,8 +40,10 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 // Function to perform binary search on the sub-array
-int binary_search(int arr[], int left, int right, int x) {
+static int binary_search(int arr[], int left, int right, int x) {
     while (left <= right) {
         int mid = left + (right - left) / 2;
         if (arr[mid] == x) return mid;
@@ -75,6 +77,7 @@ int exponential_search(int arr[], int n, int x) {
     return binary_search(arr, i / 2, (i < n) ? i : n - 1, x);
 }
 
+#ifdef SEARCH_DEMO
 /**
  * @brief Main function to demonstrate the use of exponential search.
  * 
@@ -90,10 +93,11 @@ int main() {
     int targets[] = {10, 50, 70, 100, 3, 2};
     int results[sizeof(targets) / sizeof(targets[0])];
 
-    for (int i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
         results[i] = exponential_search(arr, n, targets[i]);
         printf("Target %d is %s\n", targets[i], (results[i] == -1) ? "not found" : "found");
     }
 
     return 0;
 }
+#endif /* SEARCH_DEMO */
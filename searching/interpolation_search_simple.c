@@ -49,6 +49,8 @@
  */
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Interpolation search algorithm.
  *
@@ -79,9 +81,8 @@ int interpolation_search(int *arr, int low, int high, int target)
     }
     return -1;
 }
-/*
 
-*/
+#ifdef SEARCH_DEMO
 int main()
 {
     int arr1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
@@ -115,4 +116,5 @@ int main()
     printf("Test Case 5 - Target: %d, Result: %s\n", target5, (result5 != -1) ? "Found" : "Not Found");
 
     return 0;
-}
\ No newline at end of file
+}
+#endif /* SEARCH_DEMO */
@@ -25,6 +25,8 @@
 #include <stdio.h>
 #include <math.h>
 
+#include "search.h"
+
 /**
  * @brief Jump search function.
  * @param arr[] Sorted array to search.
@@ -56,6 +58,7 @@ int jumpSearch(int arr[], int n, int target) {
     return -1;  // Return -1 if the target is not found
 }
 
+#ifdef SEARCH_DEMO
 int main() {
     // Test cases
     int arr[] = {2, 4, 6, 8, 10, 12, 14, 16, 18, 20};
@@ -121,3 +124,4 @@ int main() {
 
     return 0;
 }
+#endif /* SEARCH_DEMO */
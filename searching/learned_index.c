@@ -0,0 +1,318 @@
+/**
+ * @file learned_index.c
+ * @brief Implementation of a learned index: piecewise linear model with bounded error.
+ *
+ * @details
+ * interpolation_search() in interpolation_search_simple.c models the whole array as one
+ * straight line from its first to its last key. That works for evenly spread keys, but on
+ * skewed data the guesses land far from the target and the search degrades towards O(n). A
+ * learned index keeps the idea of predicting a position from the key and fixes the model:
+ * - **Fitting**: the sorted array is covered by line segments, each predicting the position
+ *   of every distinct key it covers to within epsilon. Segments are fitted in one greedy pass
+ *   (the shrinking cone of FITing-Tree, a simpler relative of the optimal PGM-index
+ *   segmentation): a segment starts exactly at its first key, keeps the range of slopes that
+ *   still meet the error bound for all keys so far, and ends when the next key would make
+ *   that range empty. Smooth distributions need few segments even at small epsilon.
+ * - **Lookup**: a binary search over the segments' first keys picks the segment, its line
+ *   predicts a position, and search_lower_bound() searches the window of about 2 * epsilon
+ *   elements around it. The segment's key range also bounds the answer, so a window that does
+ *   not contain it (only possible between runs of duplicate keys) is followed by a search of
+ *   the rest of the segment, and the result is always exact.
+ *
+ * @section Performance
+ * - Build: O(n) time; O(s) memory for s segments, the array itself is not copied.
+ * - Lookup: O(log s + log epsilon).
+ *
+ * @reference
+ * - Paolo Ferragina and Giorgio Vinciguerra, "The PGM-index: a fully-dynamic compressed
+ *   learned index with provable worst-case bounds", 2020.
+ * - Alex Galakatos et al., "FITing-Tree: A Data-aware Index Structure", 2019.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#include "search.h"
+#include "learned_index.h"
+
+struct learned_index {
+    const int *sorted;
+    int n;
+    int epsilon;
+    int segments;
+    int capacity;
+    int *first_key; /**< First key of each segment. */
+    int *first_pos; /**< Position of the first occurrence of that key. */
+    double *slope;  /**< Positions per unit of key in each segment. */
+};
+
+/**
+ * @brief Appends a segment, growing the arrays as needed.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated.
+ */
+static int add_segment(learned_index_t *index, int key, int pos, double slope) {
+    if (index->segments == index->capacity) {
+        int capacity = index->capacity * 2;
+        int *first_key = realloc(index->first_key, capacity * sizeof(int));
+        if (first_key == NULL)
+            return -1;
+        index->first_key = first_key;
+        int *first_pos = realloc(index->first_pos, capacity * sizeof(int));
+        if (first_pos == NULL)
+            return -1;
+        index->first_pos = first_pos;
+        double *slopes = realloc(index->slope, capacity * sizeof(double));
+        if (slopes == NULL)
+            return -1;
+        index->slope = slopes;
+        index->capacity = capacity;
+    }
+    index->first_key[index->segments] = key;
+    index->first_pos[index->segments] = pos;
+    index->slope[index->segments] = slope;
+    index->segments++;
+    return 0;
+}
+
+/**
+ * @brief Fits the segments, each covering the distinct keys from one position to the next.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated.
+ */
+static int fit_segments(learned_index_t *index) {
+    const int *arr = index->sorted;
+    int n = index->n;
+    double epsilon = index->epsilon;
+    int i = 0;
+
+    while (i < n) {
+        int key0 = arr[i];
+        int pos0 = i;
+        double low = 0.0, high = HUGE_VAL;
+
+        int j = i;
+        while (j < n && arr[j] == key0)
+            j++;
+        while (j < n) {
+            // Slopes that predict the first occurrence of arr[j] to within epsilon
+            double dx = (double)arr[j] - (double)key0;
+            double fit_low = (j - epsilon - pos0) / dx;
+            double fit_high = (j + epsilon - pos0) / dx;
+            if (fit_low > high || fit_high < low)
+                break;
+            if (fit_low > low)
+                low = fit_low;
+            if (fit_high < high)
+                high = fit_high;
+
+            int key = arr[j];
+            while (j < n && arr[j] == key)
+                j++;
+        }
+
+        if (add_segment(index, key0, pos0, high == HUGE_VAL ? 0.0 : (low + high) / 2) != 0)
+            return -1;
+        i = j;
+    }
+    return 0;
+}
+
+learned_index_t *learned_index_create(const int *sorted, int n, int epsilon) {
+    if (n < 0 || (sorted == NULL && n > 0) || epsilon < 0) {
+        return NULL;
+    }
+    learned_index_t *index = malloc(sizeof(*index));
+    if (index == NULL) {
+        return NULL;
+    }
+    index->sorted = sorted;
+    index->n = n;
+    index->epsilon = epsilon;
+    index->segments = 0;
+    index->capacity = 16;
+    index->first_key = malloc(index->capacity * sizeof(int));
+    index->first_pos = malloc(index->capacity * sizeof(int));
+    index->slope = malloc(index->capacity * sizeof(double));
+    if (index->first_key == NULL || index->first_pos == NULL || index->slope == NULL ||
+        fit_segments(index) != 0) {
+        learned_index_destroy(index);
+        return NULL;
+    }
+    return index;
+}
+
+void learned_index_destroy(learned_index_t *index) {
+    if (index != NULL) {
+        free(index->first_key);
+        free(index->first_pos);
+        free(index->slope);
+        free(index);
+    }
+}
+
+int learned_index_segments(const learned_index_t *index) {
+    return index->segments;
+}
+
+int learned_index_lower_bound(const learned_index_t *index, int target) {
+    const int *arr = index->sorted;
+    int s = search_upper_bound(index->first_key, index->segments, target) - 1;
+    if (s < 0) {
+        return 0;  // Below the first key (or an empty array)
+    }
+
+    // The answer lies between the segment's first position and the next segment's
+    int start = index->first_pos[s];
+    int end = s + 1 < index->segments ? index->first_pos[s + 1] : index->n;
+    double predicted = start + index->slope[s] * ((double)target - index->first_key[s]);
+    if (predicted > end)
+        predicted = end;
+    long long guess = (long long)predicted;
+
+    // Search the error window, with one position of slack for targets between keys
+    int low = guess - index->epsilon - 1 < start ? start : (int)(guess - index->epsilon - 1);
+    int high = guess + index->epsilon + 2 > end ? end : (int)(guess + index->epsilon + 2);
+
+    int result = low + search_lower_bound(arr + low, high - low, target);
+    if (result == low && low > start && arr[low - 1] >= target) {
+        result = start + search_lower_bound(arr + start, low - start, target);
+    } else if (result == high && high < end && arr[high] < target) {
+        result = high + search_lower_bound(arr + high, end - high, target);
+    }
+    return result;
+}
+
+int learned_index_find(const learned_index_t *index, int target) {
+    int i = learned_index_lower_bound(index, target);
+    return i < index->n && index->sorted[i] == target ? i : -1;
+}
+
+#ifdef SEARCH_DEMO
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int random_int(void) {
+    return (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+}
+
+/**
+ * @brief Checks an index against search_lower_bound() for keys, gaps and random targets.
+ */
+static void check_index(const int *arr, int n, int epsilon) {
+    learned_index_t *index = learned_index_create(arr, n, epsilon);
+    assert(index != NULL);
+    for (int i = 0; i < n; i++) {
+        assert(learned_index_lower_bound(index, arr[i]) == search_lower_bound(arr, n, arr[i]));
+        if (arr[i] != INT_MAX) {
+            int gap = arr[i] + 1;
+            assert(learned_index_lower_bound(index, gap) == search_lower_bound(arr, n, gap));
+        }
+    }
+    for (int t = 0; t < 1000; t++) {
+        int target = random_int();
+        assert(learned_index_lower_bound(index, target) == search_lower_bound(arr, n, target));
+        assert(learned_index_find(index, target) == binary_search_branchless(arr, n, target));
+    }
+    assert(learned_index_lower_bound(index, INT_MIN) == search_lower_bound(arr, n, INT_MIN));
+    assert(learned_index_lower_bound(index, INT_MAX) == search_lower_bound(arr, n, INT_MAX));
+    learned_index_destroy(index);
+}
+
+/**
+ * @brief Driver code to demonstrate the learned index.
+ *
+ * Checks lookups against search_lower_bound() on uniform, skewed, duplicate-heavy and extreme
+ * data for several error bounds, then times random lookups in a large array of keys with a
+ * smooth distribution against a plain binary search.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int keys[] = {2, 3, 5, 8, 13, 21, 34, 55, 89};
+    int n1 = sizeof(keys) / sizeof(keys[0]);
+    learned_index_t *small = learned_index_create(keys, n1, 1);
+    assert(small != NULL);
+    printf("find(21) = %d, lower_bound(50) = %d, %d segments\n", learned_index_find(small, 21),
+           learned_index_lower_bound(small, 50), learned_index_segments(small));
+    assert(learned_index_find(small, 21) == 5);
+    assert(learned_index_find(small, 22) == -1);
+    assert(learned_index_lower_bound(small, 50) == 7);
+    assert(learned_index_lower_bound(small, 1) == 0);
+    assert(learned_index_lower_bound(small, 90) == n1);
+    learned_index_destroy(small);
+    assert(learned_index_create(keys, n1, -1) == NULL);
+    learned_index_t *empty = learned_index_create(NULL, 0, 4);
+    assert(empty != NULL && learned_index_lower_bound(empty, 7) == 0);
+    learned_index_destroy(empty);
+
+    enum { M = 20000 };
+    static int arr[M];
+    srand(89);
+    for (int epsilon = 0; epsilon <= 64; epsilon = epsilon ? epsilon * 4 : 1) {
+        // Uniform, quadratic (skewed, with duplicates at the start), long runs of duplicates,
+        // and keys at both extremes of the int range
+        for (int i = 0; i < M; i++)
+            arr[i] = 3 * i + rand() % 3;
+        check_index(arr, M, epsilon);
+        for (int i = 0; i < M; i++)
+            arr[i] = (int)((long long)i * i / M);
+        check_index(arr, M, epsilon);
+        for (int i = 0; i < M; i++)
+            arr[i] = i / 500 * 7;
+        check_index(arr, M, epsilon);
+        for (int i = 0; i < M; i++)
+            arr[i] = i < M / 2 ? INT_MIN + i : INT_MAX - (M - 1 - i);
+        check_index(arr, M, epsilon);
+    }
+
+    // Random lookups in 16M keys with random gaps between them
+    enum { N = 1 << 24, LOOKUPS = 1 << 21, EPSILON = 32 };
+    int *sorted = malloc(N * sizeof(int));
+    int *targets = malloc(LOOKUPS * sizeof(int));
+    assert(sorted != NULL && targets != NULL);
+    int key = 0;
+    for (int i = 0; i < N; i++) {
+        key += 1 + rand() % 4;
+        sorted[i] = key;
+    }
+    for (int i = 0; i < LOOKUPS; i++) {
+        targets[i] = (int)((unsigned)random_int() % (unsigned)key);
+    }
+    clock_t start = clock();
+    learned_index_t *index = learned_index_create(sorted, N, EPSILON);
+    double t_build = seconds_since(start);
+    assert(index != NULL);
+
+    long long sum_binary = 0, sum_learned = 0;
+    start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        sum_binary += search_lower_bound(sorted, N, targets[i]);
+    }
+    double t_binary = seconds_since(start);
+    start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        sum_learned += learned_index_lower_bound(index, targets[i]);
+    }
+    double t_learned = seconds_since(start);
+    assert(sum_binary == sum_learned);
+    printf("%d keys, epsilon %d: %d segments built in %.3fs\n", N, EPSILON,
+           learned_index_segments(index), t_build);
+    printf("%d lookups: binary search %.3fs, learned index %.3fs\n", LOOKUPS, t_binary,
+           t_learned);
+    learned_index_destroy(index);
+    free(sorted);
+    free(targets);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SEARCH_DEMO */
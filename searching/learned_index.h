@@ -0,0 +1,58 @@
+/**
+ * @file learned_index.h
+ * @brief Learned index: a piecewise linear model of a sorted int array with bounded error.
+ *
+ * @details
+ * A learned index predicts where a key sits in a sorted array from the key itself, and then
+ * searches only a small window around the prediction. The model is a list of line segments,
+ * each of which predicts every key it covers to within epsilon positions, so a lookup costs
+ * one search over the (few) segment start keys plus a search of about 2 * epsilon elements.
+ *
+ * The index refers to the array it was built over, which must stay alive and unchanged.
+ *
+ * @section Example Usage
+ * @code
+ * learned_index_t *index = learned_index_create(keys, n, 32);
+ * int i = learned_index_find(index, key); // same as a binary search of keys
+ * learned_index_destroy(index);
+ * @endcode
+ */
+
+#ifndef LEARNED_INDEX_H
+#define LEARNED_INDEX_H
+
+typedef struct learned_index learned_index_t;
+
+/**
+ * @brief Fits a learned index over a sorted array.
+ *
+ * @param sorted Array sorted in ascending order; it is searched by the index, not copied.
+ * @param n The number of elements in the array.
+ * @param epsilon Largest error allowed between a predicted and an actual position, >= 0.
+ * @return The index, or NULL if the arguments are invalid or memory cannot be allocated.
+ */
+learned_index_t *learned_index_create(const int *sorted, int n, int epsilon);
+
+/**
+ * @brief Frees an index (but not the array it refers to).
+ *
+ * @param index The index, may be NULL.
+ */
+void learned_index_destroy(learned_index_t *index);
+
+/**
+ * @brief Returns the number of line segments in the model.
+ */
+int learned_index_segments(const learned_index_t *index);
+
+/**
+ * @brief Returns the index of the first element not less than target, or n if there is none.
+ */
+int learned_index_lower_bound(const learned_index_t *index, int target);
+
+/**
+ * @brief Returns the index of the first element equal to target, or -1.
+ */
+int learned_index_find(const learned_index_t *index, int target);
+
+#endif /* LEARNED_INDEX_H */
@@ -16,6 +16,8 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Bidirectional linear search function.
  * @param arr[] Array to search.
@@ -42,6 +44,7 @@ int bidirectional_linear_search(int arr[], int size, int target) {
     return -1; // Target not found
 }
 
+#ifdef SEARCH_DEMO
 int main() {
     // Test Case 1: Small array with target in the middle
     int arr1[] = {1, 2, 3, 4, 5};
@@ -74,11 +77,12 @@ int main() {
     printf("Searching for %d. Result: %d\n", target5, bidirectional_linear_search(arr5, size5, target5));
 
     // Test Case 6: Empty array
-    int arr6[] = {};
-    int size6 = sizeof(arr6) / sizeof(arr6[0]);
+    int arr6[1] = {0};
+    int size6 = 0;
     int target6 = 7;
     printf("Searching for %d. Result: %d\n", target6, bidirectional_linear_search(arr6, size6, target6));
 
     // Add more test cases as needed
     return 0;
 }
+#endif /* SEARCH_DEMO */
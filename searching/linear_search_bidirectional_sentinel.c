@@ -24,6 +24,8 @@
 #include <stdio.h>
 #include <assert.h>
 
+#include "search.h"
+
 /**
  * @brief Performs bidirectional sentinel linear search to find the target in an array.
  * @param arr[] Array to search.
@@ -75,11 +77,12 @@ int linear_search_bidirectional_sentinel(int arr[], int size, int target) {
     return -1; // Target not found
 }
 
+#ifdef SEARCH_DEMO
 /**
  * @brief Runs a series of test cases to validate the correctness of the search function.
  * Uses assertions to ensure expected behavior. Fails if any test case is incorrect.
  */
-void run_tests() {
+static void run_tests() {
     // Test Case 1: Target in the middle of the array
     int arr1[] = {1, 2, 3, 4, 5};
     int size1 = sizeof(arr1) / sizeof(arr1[0]);
@@ -117,8 +120,8 @@ void run_tests() {
     assert(linear_search_bidirectional_sentinel(arr6, size6, target6) == 0);
 
     // Test Case 7: Empty array
-    int arr7[] = {};
-    int size7 = sizeof(arr7) / sizeof(arr7[0]);
+    int arr7[1] = {0};
+    int size7 = 0;
     int target7 = 100;
     assert(linear_search_bidirectional_sentinel(arr7, size7, target7) == -1);
 
@@ -139,3 +142,4 @@ int main() {
     printf("All test cases passed successfully!\n");
     return 0;
 }
+#endif /* SEARCH_DEMO */
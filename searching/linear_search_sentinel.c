@@ -36,6 +36,8 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Linear search with sentinel function.
  * @param arr[] Array to search.
@@ -69,6 +71,8 @@ int linear_search_sentinel(int arr[], int size, int target)
         return -1;
     }
 }
+
+#ifdef SEARCH_DEMO
 int main() {
     // Test cases
     int arr1[] = {1, 3, 5, 7, 9};
@@ -123,4 +127,5 @@ int main() {
     printf("Searching for %d. Result: %d\n", target10, linear_search_sentinel(arr10, size10, target10));
 
     return 0;
-}
\ No newline at end of file
+}
+#endif /* SEARCH_DEMO */
@@ -0,0 +1,324 @@
+/**
+ * @file linear_search_simd.c
+ * @brief SIMD linear search (SSE2, AVX2, AVX-512), selected at run time.
+ *
+ * @details
+ * The linear searches in linear_search_simple.c and its sentinel and bidirectional variants
+ * compare one element per iteration, and for the short arrays where a linear search is the
+ * right choice that loop overhead is most of the cost. linear_search_simd() compares a whole
+ * vector of elements with the target in one instruction instead:
+ * - The target is broadcast to every lane once.
+ * - The main loop compares four vectors per iteration (16, 32 or 64 ints for SSE2, AVX2 or
+ *   AVX-512), ORs the results and tests them with a single branch, so a miss costs one
+ *   predictable branch per block.
+ * - When a block matches, a movemask (or the AVX-512 compare mask) turns the comparisons into
+ *   a bit per element, and counting its trailing zeros gives the index of the first match.
+ * - The remainder is handled one vector at a time, and the last few elements by a scalar
+ *   loop; AVX-512 instead finishes with a masked load and compare that cannot fault.
+ *
+ * The kernel is chosen from what the CPU supports, as detected once by search_simd_level().
+ * The loads are unaligned, so any array and any offset into one can be searched.
+ *
+ * @section Performance
+ * - Time Complexity: O(n), with n / W compares for W-lane vectors.
+ * - Space Complexity: O(1).
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+
+#include "search.h"
+#include "search_internal.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LINEAR_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Scalar fallback, also used for the tails of the SSE2 and AVX2 kernels.
+ */
+static int find_scalar(const int *arr, int n, int target) {
+    for (int i = 0; i < n; i++) {
+        if (arr[i] == target) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#ifdef LINEAR_SEARCH_X86
+
+/**
+ * @brief SSE2: 4 lanes per vector, 16 elements per iteration.
+ */
+__attribute__((target("sse2")))
+static int find_sse2(const int *arr, int n, int target) {
+    __m128i x = _mm_set1_epi32(target);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i eq0 = _mm_cmpeq_epi32(x, _mm_loadu_si128((const __m128i *)(arr + i)));
+        __m128i eq1 = _mm_cmpeq_epi32(x, _mm_loadu_si128((const __m128i *)(arr + i + 4)));
+        __m128i eq2 = _mm_cmpeq_epi32(x, _mm_loadu_si128((const __m128i *)(arr + i + 8)));
+        __m128i eq3 = _mm_cmpeq_epi32(x, _mm_loadu_si128((const __m128i *)(arr + i + 12)));
+        __m128i any = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+        if (_mm_movemask_epi8(any)) {
+            // One bit per element, in order
+            __m128i packed = _mm_packs_epi16(_mm_packs_epi32(eq0, eq1), _mm_packs_epi32(eq2, eq3));
+            return i + __builtin_ctz((unsigned)_mm_movemask_epi8(packed));
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(x, _mm_loadu_si128((const __m128i *)(arr + i)));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask) {
+            return i + __builtin_ctz((unsigned)mask);
+        }
+    }
+    int tail = find_scalar(arr + i, n - i, target);
+    return tail < 0 ? -1 : i + tail;
+}
+
+/**
+ * @brief AVX2: 8 lanes per vector, 32 elements per iteration.
+ */
+__attribute__((target("avx2")))
+static int find_avx2(const int *arr, int n, int target) {
+    __m256i x = _mm256_set1_epi32(target);
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i eq0 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i *)(arr + i)));
+        __m256i eq1 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i *)(arr + i + 8)));
+        __m256i eq2 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i *)(arr + i + 16)));
+        __m256i eq3 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i *)(arr + i + 24)));
+        __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+        if (!_mm256_testz_si256(any, any)) {
+            // One bit per element, eight per vector
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq0)) |
+                            (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq1)) << 8 |
+                            (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq2)) << 16 |
+                            (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq3)) << 24;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i *)(arr + i)));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask) {
+            return i + __builtin_ctz((unsigned)mask);
+        }
+    }
+    int tail = find_scalar(arr + i, n - i, target);
+    return tail < 0 ? -1 : i + tail;
+}
+
+/**
+ * @brief AVX-512: 16 lanes per vector, 64 elements per iteration, masked tail.
+ */
+__attribute__((target("avx512f")))
+static int find_avx512(const int *arr, int n, int target) {
+    __m512i x = _mm512_set1_epi32(target);
+    int i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        __mmask16 eq0 = _mm512_cmpeq_epi32_mask(x, _mm512_loadu_si512(arr + i));
+        __mmask16 eq1 = _mm512_cmpeq_epi32_mask(x, _mm512_loadu_si512(arr + i + 16));
+        __mmask16 eq2 = _mm512_cmpeq_epi32_mask(x, _mm512_loadu_si512(arr + i + 32));
+        __mmask16 eq3 = _mm512_cmpeq_epi32_mask(x, _mm512_loadu_si512(arr + i + 48));
+        if (eq0 | eq1 | eq2 | eq3) {
+            unsigned long long mask = (unsigned long long)eq0 | (unsigned long long)eq1 << 16 |
+                                      (unsigned long long)eq2 << 32 |
+                                      (unsigned long long)eq3 << 48;
+            return i + __builtin_ctzll(mask);
+        }
+    }
+    for (; i < n; i += 16) {
+        // Lanes past the end are neither loaded nor compared
+        __mmask16 valid = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(valid, arr + i);
+        __mmask16 eq = _mm512_mask_cmpeq_epi32_mask(valid, x, v);
+        if (eq) {
+            return i + __builtin_ctz((unsigned)eq);
+        }
+    }
+    return -1;
+}
+
+#endif /* LINEAR_SEARCH_X86 */
+
+/**
+ * @brief A search kernel and the name of its instruction set.
+ */
+typedef struct {
+    int (*find)(const int *arr, int n, int target);
+    const char *isa;
+} linear_search_kernel_t;
+
+static const linear_search_kernel_t kernel_scalar = {find_scalar, "scalar"};
+#ifdef LINEAR_SEARCH_X86
+static const linear_search_kernel_t kernel_sse2 = {find_sse2, "sse2"};
+static const linear_search_kernel_t kernel_avx2 = {find_avx2, "avx2"};
+static const linear_search_kernel_t kernel_avx512 = {find_avx512, "avx512"};
+#endif
+
+static int simd_level = -1;
+
+/**
+ * @brief Detects the SIMD instruction sets usable by libsearch, once.
+ *
+ * Concurrent first calls all store the same value, so a relaxed atomic is enough.
+ *
+ * @return SEARCH_SIMD_AVX512, SEARCH_SIMD_AVX2, SEARCH_SIMD_SSE2 or SEARCH_SIMD_NONE.
+ */
+int search_simd_level(void) {
+    int level = __atomic_load_n(&simd_level, __ATOMIC_RELAXED);
+
+    if (level < 0) {
+        level = SEARCH_SIMD_NONE;
+#ifdef LINEAR_SEARCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            level = SEARCH_SIMD_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            level = SEARCH_SIMD_AVX2;
+        } else if (__builtin_cpu_supports("sse2")) {
+            level = SEARCH_SIMD_SSE2;
+        }
+#endif
+        __atomic_store_n(&simd_level, level, __ATOMIC_RELAXED);
+    }
+    return level;
+}
+
+/**
+ * @brief Returns the best kernel for this CPU.
+ */
+static const linear_search_kernel_t *linear_search_kernel(void) {
+#ifdef LINEAR_SEARCH_X86
+    switch (search_simd_level()) {
+    case SEARCH_SIMD_AVX512:
+        return &kernel_avx512;
+    case SEARCH_SIMD_AVX2:
+        return &kernel_avx2;
+    case SEARCH_SIMD_SSE2:
+        return &kernel_sse2;
+    }
+#endif
+    return &kernel_scalar;
+}
+
+/**
+ * @brief Finds the first occurrence of target with the widest SIMD kernel the CPU supports.
+ *
+ * @param arr Array to search; it does not need to be sorted or aligned.
+ * @param n The number of elements in the array.
+ * @param target Element to search for.
+ * @return Index of the first element equal to target, otherwise -1.
+ */
+int linear_search_simd(const int *arr, int n, int target) {
+    if (n <= 0) {
+        return -1;
+    }
+    return linear_search_kernel()->find(arr, n, target);
+}
+
+/**
+ * @brief Returns the name of the kernel in use: "avx512", "avx2", "sse2" or "scalar".
+ */
+const char *linear_search_simd_isa(void) {
+    return linear_search_kernel()->isa;
+}
+
+#ifdef SEARCH_DEMO
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Checks a kernel against the scalar loop for every length, offset and match position.
+ */
+static void check_kernel(const linear_search_kernel_t *kernel) {
+    enum { MAX_N = 300 };
+    static int arr[MAX_N + 3];
+
+    for (int n = 0; n <= MAX_N; n++) {
+        for (int offset = 0; offset < 3; offset++) {
+            int *a = arr + offset;
+            for (int i = 0; i < n; i++) {
+                a[i] = rand() % 1000 + 1;
+            }
+            // Absent, then at every position (earlier copies of it must win)
+            assert(kernel->find(a, n, 0) == -1);
+            for (int pos = n - 1; pos >= 0; pos--) {
+                a[pos] = 0;
+                assert(kernel->find(a, n, 0) == pos);
+            }
+            for (int t = 1; t <= 10; t++) {
+                assert(kernel->find(a, n, t) == find_scalar(a, n, t));
+            }
+        }
+    }
+    printf("%s kernel ok\n", kernel->isa);
+}
+
+/**
+ * @brief Driver code to demonstrate the SIMD linear search.
+ *
+ * Checks every kernel the CPU supports against the scalar loop, then times many searches of
+ * short arrays with linear_search() and linear_search_simd().
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {4, 8, 15, 16, 23, 42, 15};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    printf("Searching for 15. Result: %d\n", linear_search_simd(arr1, n1, 15));
+    assert(linear_search_simd(arr1, n1, 15) == 2);
+    assert(linear_search_simd(arr1, n1, 42) == 5);
+    assert(linear_search_simd(arr1, n1, 7) == -1);
+    assert(linear_search_simd(NULL, 0, 7) == -1);
+    printf("Using the %s kernel.\n", linear_search_simd_isa());
+
+    srand(79);
+    check_kernel(&kernel_scalar);
+#ifdef LINEAR_SEARCH_X86
+    if (__builtin_cpu_supports("sse2"))
+        check_kernel(&kernel_sse2);
+    if (__builtin_cpu_supports("avx2"))
+        check_kernel(&kernel_avx2);
+    if (__builtin_cpu_supports("avx512f"))
+        check_kernel(&kernel_avx512);
+#endif
+
+    // Searches of short arrays, for targets spread over the array and beyond it
+    enum { LEN = 256, ROUNDS = 200000 };
+    static int table[LEN];
+    for (int i = 0; i < LEN; i++) {
+        table[i] = 3 * i;
+    }
+    long long sum_simple = 0, sum_simd = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        sum_simple += linear_search(table, LEN, r % (4 * LEN));
+    }
+    double t_simple = seconds_since(start);
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        sum_simd += linear_search_simd(table, LEN, r % (4 * LEN));
+    }
+    double t_simd = seconds_since(start);
+    assert(sum_simple == sum_simd);
+    printf("%d searches of %d ints: linear_search %.3fs, linear_search_simd %.3fs\n", ROUNDS,
+           LEN, t_simple, t_simd);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SEARCH_DEMO */
@@ -34,6 +34,8 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Linear search function.
  * @param arr[] Array to search.
@@ -53,6 +55,7 @@ int linear_search(int arr[], int size, int target)
     return -1;
 }
 
+#ifdef SEARCH_DEMO
 int main() {
     // Test cases
     int arr1[] = {1, 3, 5, 7, 9};
@@ -72,3 +75,4 @@ int main() {
 
     return 0;
 }
+#endif /* SEARCH_DEMO */
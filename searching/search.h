@@ -0,0 +1,67 @@
+/**
+ * @file search.h
+ * @brief Public interface of libsearch, the searching algorithms in this directory.
+ *
+ * @details
+ * Every file in searching/ is one translation unit of the library and exports the function
+ * it is named after. The classic algorithms keep their original signatures; they return the
+ * index of the target, or -1 if it is not present.
+ *
+ * Each file also contains a main() driver that is only compiled when SEARCH_DEMO is defined.
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+/*
+ * Classic searches of an int array. The ones taking left/right (or low/high) search the
+ * inclusive range arr[left..right]; the others search arr[0..size).
+ */
+int binarySearch(int arr[], int left, int right, int target);
+int ternarySearch(int arr[], int left, int right, int target);
+int interpolation_search(int *arr, int low, int high, int target);
+int exponential_search(int arr[], int n, int x);
+int jumpSearch(int arr[], int n, int target);
+int linear_search(int arr[], int size, int target);
+int linear_search_sentinel(int arr[], int size, int target);
+int bidirectional_linear_search(int arr[], int size, int target);
+int linear_search_bidirectional_sentinel(int arr[], int size, int target);
+
+/**
+ * @brief Returns the index of the first element of a sorted array that is not less than
+ *        target, or n if there is none (binary_search_branchless.c).
+ */
+int search_lower_bound(const int *arr, int n, int target);
+
+/**
+ * @brief Returns the index of the first element of a sorted array that is greater than
+ *        target, or n if there is none (binary_search_branchless.c).
+ */
+int search_upper_bound(const int *arr, int n, int target);
+
+/**
+ * @brief Returns the index of the first occurrence of target in a sorted array, or -1.
+ */
+int binary_search_branchless(const int *arr, int n, int target);
+
+/**
+ * @brief Writes to out[i] the search_lower_bound() of queries[i] for m queries, running groups
+ *        of searches in lockstep so their cache misses overlap (search_many.c).
+ *
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int search_many(const int *sorted, int n, const int *queries, int m, int *out);
+
+/**
+ * @brief Returns the index of the first element equal to target, or -1, comparing a vector of
+ *        elements at a time with the widest SIMD kernel the CPU supports (linear_search_simd.c).
+ */
+int linear_search_simd(const int *arr, int n, int target);
+
+/**
+ * @brief Returns the name of the kernel linear_search_simd() uses: "avx512", "avx2", "sse2" or
+ *        "scalar".
+ */
+const char *linear_search_simd_isa(void);
+
+#endif /* SEARCH_H */
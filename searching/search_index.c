@@ -0,0 +1,414 @@
+/**
+ * @file search_index.c
+ * @brief Implementation of Eytzinger and S+-tree search indexes over a sorted array.
+ *
+ * @details
+ * A binary search over a large sorted array reads one cache line per level, and because the
+ * elements of the top levels are spread across the whole array each of those reads is a
+ * separate miss. search_index_create() copies the array into one of two layouts that keep
+ * the elements a search visits close together:
+ * - **Eytzinger** (breadth-first) order puts the root at index 1 and the children of node k
+ *   at 2k and 2k + 1. The top levels of the tree share the first few cache lines, which stay
+ *   cached across searches. The 16 descendants four levels below node k sit at 16k..16k+15,
+ *   which is one 64-byte line, so each step prefetches it. The search loop has no branch on
+ *   the data: it descends with k = 2k + (key < target) and recovers the answer from the
+ *   trailing ones of k at the end. The answer's position in the sorted array follows from k
+ *   alone: its in-order position in the perfect tree of the same height, less the missing
+ *   nodes of the last level that would come before it.
+ * - **S+-tree** (static B+-tree) packs 16 sorted keys into each node, one cache line, with
+ *   17 children, so a search reads about log17(n) lines instead of log2(n). The leaves are
+ *   the sorted array itself, padded to whole nodes, and each internal key is a copy of the
+ *   smallest key under the child to its right. A search ends in a leaf slot, which is the
+ *   answer's position. Within a node the number of keys below the target is counted with
+ *   four SSE2 comparisons where available. Node k's children in the layer below are nodes
+ *   17k to 17k + 16, so no child pointers are stored.
+ *
+ * Neither layout stores positions next to the keys, so a search costs no memory access
+ * beyond the keys it compares.
+ *
+ * @section Performance
+ * - Build: O(n) time; n + 1 ints of memory for Eytzinger, about 17n / 16 for the S+-tree.
+ * - Search: O(log n); about log2(n) - 4 cache misses for Eytzinger with prefetching and
+ *   log17(n) + 1 for the S+-tree, against log2(n) for a binary search.
+ *
+ * @reference
+ * - Paul-Virak Khuong and Pat Morin, "Array Layouts for Comparison-Based Searching", 2017.
+ * - Sergey Slotin, "Algorithms for Modern Hardware", chapters "Eytzinger Binary Search" and
+ *   "Search Trees".
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SEARCH_INDEX_SSE2 1
+#endif
+
+#include "search.h"
+#include "search_index.h"
+#include "search_internal.h"
+
+/** Keys per S+-tree node: one 64-byte cache line. */
+#define STREE_KEYS 16
+/** Most S+-tree layers: INT_MAX keys fill 2^27 leaves, which 17-way nodes cover in 8. */
+#define STREE_MAX_HEIGHT 8
+/** Alignment of the key array, so that nodes and Eytzinger blocks start on a cache line. */
+#define SEARCH_INDEX_ALIGN 64
+
+struct search_index {
+    search_index_layout_t layout;
+    int n;
+    int height;                       /**< Eytzinger: floor(log2 n); S+-tree: layers. */
+    size_t offset[STREE_MAX_HEIGHT]; /**< S+-tree: first node of each layer, leaves first. */
+    int *keys;                        /**< Keys in layout order, aligned to SEARCH_INDEX_ALIGN. */
+    void *memory;                     /**< Allocation holding keys. */
+};
+
+/**
+ * @brief Returns floor(log2 x) for x >= 1.
+ */
+static inline int floor_log2(size_t x) {
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned long long) * CHAR_BIT) - 1 - __builtin_clzll(x);
+#else
+    int log = 0;
+    while (x >>= 1)
+        log++;
+    return log;
+#endif
+}
+
+/**
+ * @brief State of the in-order walk that fills the Eytzinger layout.
+ */
+typedef struct {
+    const int *sorted;
+    int n;
+    int next; /**< Next element of the sorted array to place. */
+    int *keys;
+} index_build_t;
+
+/**
+ * @brief Fills the Eytzinger subtree rooted at node k.
+ */
+static void eytzinger_build(index_build_t *build, size_t k) {
+    if (k <= (size_t)build->n) {
+        eytzinger_build(build, 2 * k);
+        build->keys[k] = build->sorted[build->next++];
+        eytzinger_build(build, 2 * k + 1);
+    }
+}
+
+/**
+ * @brief Fills the internal layers of the S+-tree whose leaves are already in place.
+ *
+ * Key i of node k separates its children 17k + i and 17k + i + 1, and is the smallest key
+ * under the latter (the first key of its leftmost leaf), or INT_MAX if there is no such
+ * child.
+ */
+static void stree_build(search_index_t *index) {
+    for (int h = 1; h < index->height; h++) {
+        size_t begin = index->offset[h];
+        size_t end = h + 1 < index->height ? index->offset[h + 1] : begin + 1;
+        size_t below = begin - index->offset[h - 1];
+        for (size_t k = 0; k < end - begin; k++) {
+            for (int i = 0; i < STREE_KEYS; i++) {
+                size_t child = k * (STREE_KEYS + 1) + (size_t)i + 1;
+                int key = INT_MAX;
+                if (child < below) {
+                    for (int l = h - 1; l > 0; l--)
+                        child *= STREE_KEYS + 1;
+                    key = index->keys[child * STREE_KEYS];
+                }
+                index->keys[(begin + k) * STREE_KEYS + (size_t)i] = key;
+            }
+        }
+    }
+}
+
+search_index_t *search_index_create(const int *sorted, int n, search_index_layout_t layout) {
+    if (n < 0 || (sorted == NULL && n > 0) || layout < 0 || layout >= SEARCH_INDEX_LAYOUT_COUNT) {
+        return NULL;
+    }
+    search_index_t *index = malloc(sizeof(*index));
+    if (index == NULL) {
+        return NULL;
+    }
+
+    size_t slots;
+    index->layout = layout;
+    index->n = n;
+    if (layout == SEARCH_INDEX_EYTZINGER) {
+        // Slot 0 is unused and stands for "no element"
+        index->height = n > 0 ? floor_log2((size_t)n) : 0;
+        slots = (size_t)n + 1;
+    } else {
+        // Leaves first, then each layer of internal nodes up to the single root
+        size_t nodes = n > STREE_KEYS ? ((size_t)n + STREE_KEYS - 1) / STREE_KEYS : 1;
+        index->height = 1;
+        index->offset[0] = 0;
+        while (nodes > 1) {
+            index->offset[index->height] = index->offset[index->height - 1] + nodes;
+            index->height++;
+            nodes = (nodes + STREE_KEYS) / (STREE_KEYS + 1);
+        }
+        slots = (index->offset[index->height - 1] + 1) * STREE_KEYS;
+    }
+
+    size_t keys_size = (slots + STREE_KEYS - 1) / STREE_KEYS * STREE_KEYS * sizeof(int);
+    index->memory = malloc(keys_size + SEARCH_INDEX_ALIGN);
+    if (index->memory == NULL) {
+        free(index);
+        return NULL;
+    }
+    uintptr_t address = (uintptr_t)index->memory;
+    address = (address + SEARCH_INDEX_ALIGN - 1) & ~(uintptr_t)(SEARCH_INDEX_ALIGN - 1);
+    index->keys = (int *)address;
+
+    if (layout == SEARCH_INDEX_EYTZINGER) {
+        index_build_t build = {sorted, n, 0, index->keys};
+        index->keys[0] = INT_MAX;
+        eytzinger_build(&build, 1);
+    } else {
+        size_t leaf_slots = index->height > 1 ? index->offset[1] * STREE_KEYS : STREE_KEYS;
+        if (n > 0)
+            memcpy(index->keys, sorted, (size_t)n * sizeof(int));
+        for (size_t i = (size_t)n; i < leaf_slots; i++)
+            index->keys[i] = INT_MAX;
+        stree_build(index);
+    }
+    return index;
+}
+void search_index_destroy(search_index_t *index) {
+    if (index != NULL) {
+        free(index->memory);
+        free(index);
+    }
+}
+
+int search_index_size(const search_index_t *index) {
+    return index->n;
+}
+
+/**
+ * @brief Returns the slot of the first key not less than target in the Eytzinger layout.
+ */
+static size_t eytzinger_lower_bound(const search_index_t *index, int target) {
+    const int *keys = index->keys;
+    size_t n = (size_t)index->n;
+    size_t k = 1;
+
+    while (k <= n) {
+        // Node k's descendants four levels down fill one cache line
+        if (16 * k <= n)
+            SEARCH_PREFETCH(keys + 16 * k);
+        k = 2 * k + (keys[k] < target);
+    }
+    // The answer is the last node where the search went left: strip the right turns (the
+    // trailing ones) and then that left turn
+    while (k & 1)
+        k >>= 1;
+    return k >> 1;
+}
+
+/**
+ * @brief Returns the position in the sorted array of the key in Eytzinger slot k, or n for 0.
+ */
+static inline int eytzinger_rank(const search_index_t *index, size_t k) {
+    if (k == 0) {
+        return index->n;
+    }
+    // In-order position of k in the perfect tree with the same number of levels
+    int level = floor_log2(k);
+    int depth = index->height;
+    size_t pos = ((2 * (k - ((size_t)1 << level)) + 1) << (depth - level)) - 1;
+    // The last level occupies the even positions of that tree, and only its first
+    // n - 2^depth + 1 nodes exist
+    size_t leaves = (size_t)index->n - ((size_t)1 << depth) + 1;
+    size_t before = (pos + 1) / 2;
+    return (int)(pos - (before > leaves ? before - leaves : 0));
+}
+
+/**
+ * @brief Returns how many of the 16 sorted keys of an S+-tree node are less than target.
+ */
+static inline int stree_node_rank(const int *node, int target) {
+#ifdef SEARCH_INDEX_SSE2
+    __m128i x = _mm_set1_epi32(target);
+    __m128i lt0 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)node));
+    __m128i lt1 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 4)));
+    __m128i lt2 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 8)));
+    __m128i lt3 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 12)));
+    __m128i lt = _mm_packs_epi16(_mm_packs_epi32(lt0, lt1), _mm_packs_epi32(lt2, lt3));
+    return __builtin_popcount((unsigned)_mm_movemask_epi8(lt));
+#else
+    int count = 0;
+    for (int i = 0; i < STREE_KEYS; i++) {
+        count += node[i] < target;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Returns the leaf slot of the first key not less than target in the S+-tree layout,
+ *        which is its position in the sorted array (n or more if there is none).
+ *
+ * Counting the separators below target picks the child that holds the answer, unless every
+ * key of that child is less than target; the leaf rank is then 16 and the slot is the first
+ * one of the next leaf, which is where the answer is.
+ */
+static size_t stree_lower_bound(const search_index_t *index, int target) {
+    size_t k = 0;
+
+    for (int h = index->height - 1; h > 0; h--) {
+        int i = stree_node_rank(index->keys + (index->offset[h] + k) * STREE_KEYS, target);
+        k = k * (STREE_KEYS + 1) + (size_t)i;
+    }
+    return k * STREE_KEYS + (size_t)stree_node_rank(index->keys + k * STREE_KEYS, target);
+}
+
+int search_index_lower_bound(const search_index_t *index, int target) {
+    if (index->layout == SEARCH_INDEX_EYTZINGER) {
+        return eytzinger_rank(index, eytzinger_lower_bound(index, target));
+    }
+    size_t slot = stree_lower_bound(index, target);
+    return slot < (size_t)index->n ? (int)slot : index->n;
+}
+
+int search_index_find(const search_index_t *index, int target) {
+    size_t slot;
+    if (index->layout == SEARCH_INDEX_EYTZINGER) {
+        slot = eytzinger_lower_bound(index, target);
+        return slot != 0 && index->keys[slot] == target ? eytzinger_rank(index, slot) : -1;
+    }
+    slot = stree_lower_bound(index, target);
+    return slot < (size_t)index->n && index->keys[slot] == target ? (int)slot : -1;
+}
+
+#ifdef SEARCH_DEMO
+static const char *layout_names[SEARCH_INDEX_LAYOUT_COUNT] = {"eytzinger", "s+-tree"};
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int random_int(void) {
+    return (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+}
+
+/**
+ * @brief Driver code to demonstrate the search indexes.
+ *
+ * Checks both layouts against search_lower_bound() on arrays of many sizes with duplicates and
+ * extreme values, then times random lookups in a large array with each of them, both as
+ * independent lookups and as a chain in which each target depends on the previous answer.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int ids[] = {3, 8, 8, 15, 42};
+    for (int layout = 0; layout < SEARCH_INDEX_LAYOUT_COUNT; layout++) {
+        search_index_t *index = search_index_create(ids, 5, layout);
+        assert(index != NULL);
+        printf("%-9s find(15) = %d, lower_bound(8) = %d\n", layout_names[layout],
+               search_index_find(index, 15), search_index_lower_bound(index, 8));
+        assert(search_index_find(index, 15) == 3);
+        assert(search_index_find(index, 9) == -1);
+        assert(search_index_lower_bound(index, 8) == 1);
+        assert(search_index_lower_bound(index, 43) == 5);
+        search_index_destroy(index);
+    }
+    assert(search_index_create(ids, -1, SEARCH_INDEX_EYTZINGER) == NULL);
+    assert(search_index_create(ids, 5, SEARCH_INDEX_LAYOUT_COUNT) == NULL);
+
+    // Many sizes, including ones that fill the trees exactly and ones just past that
+    enum { MAX_N = 1200 };
+    int arr[MAX_N];
+    srand(73);
+    for (int n = 0; n <= MAX_N; n += n < 300 ? 1 : 37) {
+        int value = n % 2 ? INT_MIN : -50;
+        for (int i = 0; i < n; i++) {
+            arr[i] = value;
+            value += rand() % 3;
+        }
+        if (n > 0 && n % 3 == 0)
+            arr[n - 1] = INT_MAX;
+        for (int layout = 0; layout < SEARCH_INDEX_LAYOUT_COUNT; layout++) {
+            search_index_t *index = search_index_create(n > 0 ? arr : NULL, n, layout);
+            assert(index != NULL && search_index_size(index) == n);
+            for (int t = 0; t < 200; t++) {
+                int target = n > 0 && t % 2 ? arr[rand() % n] ^ (t % 4 == 3) : random_int();
+                int lower = search_lower_bound(arr, n, target);
+                assert(search_index_lower_bound(index, target) == lower);
+                int found = binary_search_branchless(arr, n, target);
+                assert(search_index_find(index, target) == found);
+            }
+            assert(search_index_lower_bound(index, INT_MAX) == search_lower_bound(arr, n, INT_MAX));
+            assert(search_index_lower_bound(index, INT_MIN) == 0);
+            search_index_destroy(index);
+        }
+    }
+
+    // Random point lookups in a 64 MB array of sorted IDs
+    enum { N = 1 << 24, LOOKUPS = 1 << 21 };
+    int *sorted = malloc(N * sizeof(int));
+    int *targets = malloc(LOOKUPS * sizeof(int));
+    assert(sorted != NULL && targets != NULL);
+    for (int i = 0; i < N; i++) {
+        sorted[i] = 2 * i;
+    }
+    for (int i = 0; i < LOOKUPS; i++) {
+        targets[i] = (int)((unsigned)random_int() % (2u * N));
+    }
+
+    // Independent lookups overlap their misses; in the chain, every lookup waits for the one
+    // before it, so each memory access a search makes after its last comparison shows in full
+    long long checksum = 0;
+    int chain = 0;
+    clock_t start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        checksum += search_lower_bound(sorted, N, targets[i]);
+    }
+    double t_binary = seconds_since(start);
+    start = clock();
+    for (int i = 0; i < LOOKUPS; i++) {
+        chain = search_lower_bound(sorted, N, targets[i] ^ (chain & 1));
+    }
+    printf("%d lookups in %d ints, independent / chained:\n", LOOKUPS, N);
+    printf("  %-13s %.3fs / %.3fs\n", "binary search", t_binary, seconds_since(start));
+    for (int layout = 0; layout < SEARCH_INDEX_LAYOUT_COUNT; layout++) {
+        search_index_t *index = search_index_create(sorted, N, layout);
+        assert(index != NULL);
+        long long sum = 0;
+        int link = 0;
+        start = clock();
+        for (int i = 0; i < LOOKUPS; i++) {
+            sum += search_index_lower_bound(index, targets[i]);
+        }
+        double t_independent = seconds_since(start);
+        start = clock();
+        for (int i = 0; i < LOOKUPS; i++) {
+            link = search_index_lower_bound(index, targets[i] ^ (link & 1));
+        }
+        printf("  %-13s %.3fs / %.3fs\n", layout_names[layout], t_independent,
+               seconds_since(start));
+        assert(sum == checksum && link == chain);
+        search_index_destroy(index);
+    }
+    free(sorted);
+    free(targets);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SEARCH_DEMO */
@@ -0,0 +1,73 @@
+/**
+ * @file search_index.h
+ * @brief Read-only search indexes over a sorted int array, in cache-friendly layouts.
+ *
+ * @details
+ * A sorted array that is built once and searched many times can be copied into a layout in
+ * which a search touches fewer cache lines than a binary search over the array itself:
+ * - **SEARCH_INDEX_EYTZINGER** stores the implicit binary search tree in breadth-first
+ *   order, so the top levels share a few cache lines and the descendants four levels below a
+ *   node are contiguous and can be prefetched.
+ * - **SEARCH_INDEX_STREE** stores a static B+-tree whose nodes are 16 keys (one 64-byte cache
+ *   line) with 17 children each, so a search reads about log17(n) lines. Its leaves are a
+ *   copy of the sorted array.
+ *
+ * Searches return positions in the original sorted array, so the index can sit next to an
+ * array of payloads that stays in sorted order.
+ *
+ * @section Example Usage
+ * @code
+ * search_index_t *index = search_index_create(ids, n, SEARCH_INDEX_EYTZINGER);
+ * int i = search_index_find(index, id); // same as a binary search of ids
+ * search_index_destroy(index);
+ * @endcode
+ */
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+/**
+ * @brief Layouts available to search_index_create().
+ */
+typedef enum {
+    SEARCH_INDEX_EYTZINGER,
+    SEARCH_INDEX_STREE,
+    SEARCH_INDEX_LAYOUT_COUNT
+} search_index_layout_t;
+
+typedef struct search_index search_index_t;
+
+/**
+ * @brief Builds an index over a sorted array; the array itself is not referenced afterwards.
+ *
+ * @param sorted Array sorted in ascending order.
+ * @param n The number of elements in the array.
+ * @param layout The layout of the index.
+ * @return The index, or NULL if the arguments are invalid or memory cannot be allocated.
+ */
+search_index_t *search_index_create(const int *sorted, int n, search_index_layout_t layout);
+
+/**
+ * @brief Frees an index.
+ *
+ * @param index The index, may be NULL.
+ */
+void search_index_destroy(search_index_t *index);
+
+/**
+ * @brief Returns the number of elements indexed.
+ */
+int search_index_size(const search_index_t *index);
+
+/**
+ * @brief Returns the position in the sorted array of the first element not less than target,
+ *        or n if there is none.
+ */
+int search_index_lower_bound(const search_index_t *index, int target);
+
+/**
+ * @brief Returns the position in the sorted array of the first element equal to target, or -1.
+ */
+int search_index_find(const search_index_t *index, int target);
+
+#endif /* SEARCH_INDEX_H */
@@ -0,0 +1,34 @@
+/**
+ * @file search_internal.h
+ * @brief Helpers shared between the libsearch source files.
+ *
+ * @details
+ * This header is not part of the public interface.
+ */
+
+#ifndef SEARCH_INTERNAL_H
+#define SEARCH_INTERNAL_H
+
+/**
+ * @brief Asks the CPU to start loading the cache line holding *addr, for reading.
+ *
+ * Compiles to nothing on compilers without __builtin_prefetch.
+ */
+#if defined(__GNUC__)
+#define SEARCH_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define SEARCH_PREFETCH(addr) ((void)(addr))
+#endif
+
+/* Values returned by search_simd_level() */
+#define SEARCH_SIMD_NONE 0
+#define SEARCH_SIMD_SSE2 1
+#define SEARCH_SIMD_AVX2 2
+#define SEARCH_SIMD_AVX512 3 /* AVX-512F, which implies AVX2 */
+
+/**
+ * @brief Returns the widest SIMD instruction set the CPU supports (linear_search_simd.c).
+ */
+int search_simd_level(void);
+
+#endif /* SEARCH_INTERNAL_H */
@@ -0,0 +1,199 @@
+/**
+ * @file search_many.c
+ * @brief Batched binary search: many lookups in one sorted array, interleaved.
+ *
+ * @details
+ * A single binary search over an array larger than the caches is a chain of dependent cache
+ * misses: the next address is not known until the current load returns, so the CPU sits idle
+ * for most of each level. When many lookups are ready at once, as in a join or a bulk probe,
+ * nothing forces them to run one after another. search_many() advances a group of
+ * SEARCH_MANY_GROUP searches in lockstep (group prefetching):
+ * - All searches in a group run over the same array length, so with the branchless step of
+ *   binary_search_branchless.c they take the same number of steps and stay in step with no
+ *   bookkeeping.
+ * - At each level, every search in the group takes its step, with a load that was prefetched
+ *   during the previous level, and then prefetches the element it will compare at the next
+ *   level, whose address is known as soon as the step is taken. The misses of the whole group
+ *   are in flight together, so the group pays for about one memory latency per level instead
+ *   of one per search per level.
+ * - Small arrays, which stay cached, skip the prefetches.
+ *
+ * @section Performance
+ * - Time Complexity: O(m log n) for m queries.
+ * - Space Complexity: O(1) - one group of pointers on the stack.
+ *
+ * @reference
+ * - Shimin Chen, Anastassia Ailamaki, Phillip B. Gibbons and Todd C. Mowry, "Improving Hash
+ *   Join Performance through Prefetching", 2004.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+
+#include "search.h"
+#include "search_internal.h"
+
+/** Searches advanced together; enough to cover memory latency with independent misses. */
+#define SEARCH_MANY_GROUP 16
+/** Arrays of at least this many elements (64 KB) prefetch the next level. */
+#define SEARCH_MANY_PREFETCH_MIN (1 << 14)
+
+/**
+ * @brief Runs the lower bound searches of up to SEARCH_MANY_GROUP queries in lockstep.
+ *
+ * @param prefetch Nonzero to prefetch the element each search compares next.
+ */
+static inline void search_group(const int *sorted, int n, const int *queries, int count,
+                                int *out, int prefetch) {
+    const int *base[SEARCH_MANY_GROUP];
+    int len = n;
+
+    for (int g = 0; g < count; g++) {
+        base[g] = sorted;
+    }
+    while (len > 1) {
+        int half = len / 2;
+        int next_half = (len - half) / 2;
+        for (int g = 0; g < count; g++) {
+            base[g] += (base[g][half] < queries[g]) * half;
+            if (prefetch)
+                SEARCH_PREFETCH(base[g] + next_half);
+        }
+        len -= half;
+    }
+    for (int g = 0; g < count; g++) {
+        out[g] = (int)(base[g] - sorted) + (*base[g] < queries[g]);
+    }
+}
+
+/**
+ * @brief Finds the lower bound of many queries in one sorted array.
+ *
+ * out[i] is the index of the first element of sorted that is not less than queries[i], or n
+ * if there is none, exactly as search_lower_bound() would return. Queries may be in any order.
+ *
+ * @param sorted Array sorted in ascending order.
+ * @param n The number of elements in the array.
+ * @param queries The values to look for.
+ * @param m The number of queries.
+ * @param out Receives m positions; may not overlap queries.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int search_many(const int *sorted, int n, const int *queries, int m, int *out) {
+    if (n < 0 || m < 0 || (sorted == NULL && n > 0) ||
+        ((queries == NULL || out == NULL) && m > 0)) {
+        return -1;
+    }
+    if (n == 0) {
+        for (int i = 0; i < m; i++) {
+            out[i] = 0;
+        }
+        return 0;
+    }
+
+    int prefetch = n >= SEARCH_MANY_PREFETCH_MIN;
+    for (int i = 0; i < m; i += SEARCH_MANY_GROUP) {
+        int count = m - i < SEARCH_MANY_GROUP ? m - i : SEARCH_MANY_GROUP;
+        if (prefetch) {
+            search_group(sorted, n, queries + i, count, out + i, 1);
+        } else {
+            search_group(sorted, n, queries + i, count, out + i, 0);
+        }
+    }
+    return 0;
+}
+
+#ifdef SEARCH_DEMO
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int random_int(void) {
+    return (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+}
+
+/**
+ * @brief Driver code to demonstrate batched searching.
+ *
+ * Checks search_many() against search_lower_bound() for many array and batch sizes, then
+ * times a large batch of random probes into a large array against one search at a time.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int ids[] = {3, 8, 8, 15, 42};
+    int probes[] = {15, 8, 1, 50, 9};
+    int positions[5];
+    assert(search_many(ids, 5, probes, 5, positions) == 0);
+    for (int i = 0; i < 5; i++) {
+        printf("%d ", positions[i]);
+    }
+    printf("\n");
+    assert(positions[0] == 3 && positions[1] == 1 && positions[2] == 0 && positions[3] == 5 &&
+           positions[4] == 3);
+    assert(search_many(ids, 5, probes, -1, positions) == -1);
+    assert(search_many(NULL, 0, probes, 5, positions) == 0 && positions[0] == 0);
+    assert(search_many(ids, 5, NULL, 0, NULL) == 0);
+
+    // Batch sizes around the group size, arrays on both sides of the prefetch threshold
+    enum { MAX_M = 100, MAX_N = 40000 };
+    static int arr[MAX_N];
+    int queries[MAX_M], out[MAX_M];
+    srand(83);
+    for (int n = 1; n <= MAX_N; n = n < 64 ? n + 1 : n * 3 / 2) {
+        int value = 0;
+        for (int i = 0; i < n; i++) {
+            value += rand() % 3;
+            arr[i] = value;
+        }
+        for (int m = 0; m <= MAX_M; m += 7) {
+            for (int i = 0; i < m; i++) {
+                queries[i] = rand() % (value + 3) - 1;
+            }
+            assert(search_many(arr, n, queries, m, out) == 0);
+            for (int i = 0; i < m; i++) {
+                assert(out[i] == search_lower_bound(arr, n, queries[i]));
+            }
+        }
+    }
+
+    // A batch of random probes into a 64 MB array of sorted IDs
+    enum { N = 1 << 24, M = 1 << 21 };
+    int *sorted = malloc(N * sizeof(int));
+    int *batch = malloc(M * sizeof(int));
+    int *one = malloc(M * sizeof(int));
+    int *many = malloc(M * sizeof(int));
+    assert(sorted != NULL && batch != NULL && one != NULL && many != NULL);
+    for (int i = 0; i < N; i++) {
+        sorted[i] = 2 * i;
+    }
+    for (int i = 0; i < M; i++) {
+        batch[i] = (int)((unsigned)random_int() % (2u * N));
+    }
+    clock_t start = clock();
+    for (int i = 0; i < M; i++) {
+        one[i] = search_lower_bound(sorted, N, batch[i]);
+    }
+    double t_one = seconds_since(start);
+    start = clock();
+    assert(search_many(sorted, N, batch, M, many) == 0);
+    double t_many = seconds_since(start);
+    for (int i = 0; i < M; i++) {
+        assert(one[i] == many[i]);
+    }
+    printf("%d probes into %d ints: one at a time %.3fs, search_many %.3fs\n", M, N, t_one,
+           t_many);
+    free(sorted);
+    free(batch);
+    free(one);
+    free(many);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SEARCH_DEMO */
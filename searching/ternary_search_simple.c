@@ -11,6 +11,8 @@
 
 #include <stdio.h>
 
+#include "search.h"
+
 /**
  * @brief Ternary search algorithm.
  *
@@ -91,6 +93,7 @@ int ternarySearch(int arr[], int left, int right, int target)
     return -1; // Return -1 if the target value is not found
 }*/
  
+#ifdef SEARCH_DEMO
 /**
  * @brief Main function to test the ternary search algorithm.
  *
@@ -125,3 +128,4 @@ int main() {
     
     return 0;
 }
+#endif /* SEARCH_DEMO */
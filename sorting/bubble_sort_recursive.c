@@ -30,20 +30,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param len The number of elements in the array.
- */
-void printf_array(int *arr, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Sorts an array using recursive bubble sort algorithm.
@@ -58,7 +45,7 @@ void printf_array(int *arr, int len) {
  */
 void bubble_sort_recursive(int *arr, int n) {
     // Base case: If the array has one or zero elements, it is already sorted
-    if (n == 1) {
+    if (n <= 1) {
         return;
     }
 
@@ -76,6 +63,7 @@ void bubble_sort_recursive(int *arr, int n) {
     bubble_sort_recursive(arr, n - 1);
 }
 
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the recursive bubble sort algorithm.
  * 
@@ -93,8 +81,8 @@ int main() {
     // Sort the array using recursive bubble sort
     bubble_sort_recursive(unsorted_array, n);
     // Print the sorted array
-    printf_array(unsorted_array, n);
+    sort_print_array(unsorted_array, n);
 
     return 0;
 }
-
+#endif /* SORT_DEMO */
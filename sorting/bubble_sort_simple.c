@@ -22,20 +22,7 @@
 
 #include <stdio.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param len The number of elements in the array.
- */
-void printf_array(int *arr, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Sorts an array using bubble sort algorithm.
@@ -47,7 +34,7 @@ void printf_array(int *arr, int len) {
  * @param arr The array to be sorted.
  * @param n The number of elements in the array.
  */
-void bubble_sort(int *arr, int n) {
+void bubble_sort_simple(int *arr, int n) {
     // Outer loop for traversing through all elements
     for (int i = 0; i < n; i++) {
         // Inner loop for comparing adjacent elements
@@ -62,6 +49,7 @@ void bubble_sort(int *arr, int n) {
     }
 }
 
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the bubble sort algorithm.
  * 
@@ -77,9 +65,10 @@ int main() {
     int n = sizeof(unsorted_array) / sizeof(unsorted_array[0]);
 
     // Sort the array using bubble sort
-    bubble_sort(unsorted_array, n);
+    bubble_sort_simple(unsorted_array, n);
     // Print the sorted array
-    printf_array(unsorted_array, n);
+    sort_print_array(unsorted_array, n);
 
     return 0;
 }
+#endif /* SORT_DEMO */
@@ -0,0 +1,325 @@
+/**
+ * @file counting_sort_range.c
+ * @brief Implementation of a range-checked, parallel Counting Sort.
+ *
+ * @details
+ * counting_sort_simple() sizes its count array by the maximum value alone, so one large key
+ * makes it allocate gigabytes and a negative key indexes outside the array. This version is
+ * safe on arbitrary input:
+ * - **Offset by the minimum**: the count array covers [min, max] only, so negative keys work
+ *   and a cluster of large keys costs no more than a cluster of small ones.
+ * - **Memory cap**: the table is only built if max - min + 1 is at most a bounded multiple of n
+ *   (COUNTING_SORT_RANGE_RATIO, with a COUNTING_SORT_RANGE_MIN floor for small arrays).
+ *   counting_sort_range() falls back to radix_sort_lsd() beyond that; counting_sort_range_max()
+ *   lets the caller pick the limit and refuses instead.
+ * - **Parallel histogram**: for large arrays, min/max and the histogram are computed over one
+ *   chunk per thread on the pool from sort_pool.c, each chunk with its own counters so that no
+ *   atomics are needed; the tables are then summed.
+ * - **No scatter, no copy-back**: equal ints are indistinguishable, so after the prefix sum
+ *   every output position is simply rewritten from the counts. There is no output array to
+ *   copy back, and the rewrite is split by output position across the threads.
+ *
+ * @section Performance
+ * - Time Complexity: O(n + k) for a key range of size k, with the O(n) parts parallel.
+ * - Space Complexity: O(k), or O(p * k) for the parallel histogram on p threads (only used
+ *   when p * k <= n).
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_pool.h"
+
+/** The key range may be at most this many times the number of elements... */
+#define COUNTING_SORT_RANGE_RATIO 2
+/** ...unless it is at most this large anyway. */
+#define COUNTING_SORT_RANGE_MIN 4096
+/** Arrays of at least this size are scanned by all threads together. */
+#define COUNTING_SORT_RANGE_PARALLEL_MIN (1 << 17)
+/** Upper bound on the number of chunks. */
+#define COUNTING_SORT_RANGE_MAX_CHUNKS 64
+
+/**
+ * @brief Arguments of one chunk of the min/max and histogram passes.
+ */
+typedef struct {
+    const int *arr;
+    int n;
+    int min;         /**< Result of the min/max pass, then the key of bucket 0. */
+    int max;
+    unsigned *count; /**< Histogram of this chunk. */
+    size_t range;
+} scan_job_t;
+
+/**
+ * @brief Arguments of one chunk of the output pass.
+ */
+typedef struct {
+    int *arr;
+    const unsigned *start; /**< start[d] is the first output position of key min + d. */
+    size_t range;
+    int min;
+    int k_begin;
+    int k_end;
+} fill_job_t;
+
+/**
+ * @brief Runs fn on each of the jobs, spreading them over the pool.
+ */
+static void run_chunks(sort_pool_t *pool, void (*fn)(void *), void *jobs, size_t job_size,
+                       int chunks) {
+    sort_task_t task[COUNTING_SORT_RANGE_MAX_CHUNKS];
+    char *job = jobs;
+
+    for (int c = 1; c < chunks; c++) {
+        sort_pool_spawn(pool, &task[c], fn, job + c * job_size);
+    }
+    fn(job);
+    for (int c = chunks - 1; c >= 1; c--) {
+        sort_pool_wait(pool, &task[c]);
+    }
+}
+
+/**
+ * @brief Task body: finds the minimum and maximum of one chunk.
+ */
+static void chunk_min_max(void *arg) {
+    scan_job_t *s = arg;
+    int min = s->arr[0], max = s->arr[0];
+
+    for (int i = 1; i < s->n; i++) {
+        if (s->arr[i] < min)
+            min = s->arr[i];
+        if (s->arr[i] > max)
+            max = s->arr[i];
+    }
+    s->min = min;
+    s->max = max;
+}
+
+/**
+ * @brief Task body: counts the keys of one chunk relative to s->min.
+ */
+static void chunk_histogram(void *arg) {
+    scan_job_t *s = arg;
+
+    memset(s->count, 0, s->range * sizeof(unsigned));
+    for (int i = 0; i < s->n; i++) {
+        s->count[(unsigned)s->arr[i] - (unsigned)s->min]++;
+    }
+}
+
+/**
+ * @brief Task body: writes output positions [k_begin, k_end) from the prefix sums.
+ */
+static void chunk_fill(void *arg) {
+    const fill_job_t *f = arg;
+
+    // Find the bucket that contains k_begin: the last d with start[d] <= k_begin
+    size_t low = 0, high = f->range - 1;
+    while (low < high) {
+        size_t mid = low + (high - low + 1) / 2;
+        if (f->start[mid] <= (unsigned)f->k_begin)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    int k = f->k_begin;
+    for (size_t d = low; k < f->k_end; d++) {
+        int end = f->start[d + 1] < (unsigned)f->k_end ? (int)f->start[d + 1] : f->k_end;
+        int value = (int)((unsigned)f->min + (unsigned)d);
+        while (k < end) {
+            f->arr[k++] = value;
+        }
+    }
+}
+
+/**
+ * @brief Sorts an array with counting sort if its key range is at most max_range.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param max_range The largest acceptable max - min + 1, which bounds the count table at
+ *                  max_range counters (times the thread count for the parallel histogram).
+ * @return 0 on success, -1 if the arguments are invalid, the key range exceeds max_range or
+ *         memory cannot be allocated (the array is then left unchanged).
+ */
+int counting_sort_range_max(int *arr, int n, size_t max_range) {
+    if (n < 0 || (arr == NULL && n > 0)) {
+        return -1;
+    }
+    if (n < 2) {
+        return 0;
+    }
+
+    sort_pool_t *pool = NULL;
+    int chunks = 1;
+    if (n >= COUNTING_SORT_RANGE_PARALLEL_MIN) {
+        pool = sort_pool_default();
+        chunks = sort_pool_threads(pool);
+        if (chunks > COUNTING_SORT_RANGE_MAX_CHUNKS)
+            chunks = COUNTING_SORT_RANGE_MAX_CHUNKS;
+    }
+
+    scan_job_t scan[COUNTING_SORT_RANGE_MAX_CHUNKS];
+    for (int c = 0; c < chunks; c++) {
+        int begin = (int)((long long)n * c / chunks);
+        int end = (int)((long long)n * (c + 1) / chunks);
+        scan[c].arr = arr + begin;
+        scan[c].n = end - begin;
+    }
+    run_chunks(pool, chunk_min_max, scan, sizeof(scan[0]), chunks);
+
+    int min = scan[0].min, max = scan[0].max;
+    for (int c = 1; c < chunks; c++) {
+        if (scan[c].min < min)
+            min = scan[c].min;
+        if (scan[c].max > max)
+            max = scan[c].max;
+    }
+    long long range = (long long)max - min + 1;
+    if ((unsigned long long)range > max_range) {
+        return -1;
+    }
+
+    // Private tables only pay off if they are small next to the data
+    if ((long long)chunks * range > n) {
+        chunks = 1;
+        scan[0].arr = arr;
+        scan[0].n = n;
+    }
+
+    unsigned *start = malloc(((size_t)range + 1) * sizeof(unsigned));
+    unsigned *local = NULL;
+    if (start != NULL && chunks > 1) {
+        local = malloc((size_t)chunks * range * sizeof(unsigned));
+    }
+    if (start == NULL || (chunks > 1 && local == NULL)) {
+        free(start);
+        free(local);
+        return -1;
+    }
+
+    for (int c = 0; c < chunks; c++) {
+        scan[c].min = min;
+        scan[c].range = (size_t)range;
+        scan[c].count = chunks > 1 ? local + (size_t)c * range : start;
+    }
+    run_chunks(pool, chunk_histogram, scan, sizeof(scan[0]), chunks);
+
+    // Sum the tables and turn the totals into starting positions
+    unsigned sum = 0;
+    for (size_t d = 0; d < (size_t)range; d++) {
+        unsigned total = 0;
+        for (int c = 0; c < chunks; c++) {
+            total += scan[c].count[d];
+        }
+        start[d] = sum;
+        sum += total;
+    }
+    start[range] = sum;
+
+    // The rewrite is split by output position, so it balances however the keys are spread
+    int fill_chunks = pool != NULL ? sort_pool_threads(pool) : 1;
+    if (fill_chunks > COUNTING_SORT_RANGE_MAX_CHUNKS)
+        fill_chunks = COUNTING_SORT_RANGE_MAX_CHUNKS;
+    fill_job_t fill[COUNTING_SORT_RANGE_MAX_CHUNKS];
+    for (int c = 0; c < fill_chunks; c++) {
+        fill[c].arr = arr;
+        fill[c].start = start;
+        fill[c].range = (size_t)range;
+        fill[c].min = min;
+        fill[c].k_begin = (int)((long long)n * c / fill_chunks);
+        fill[c].k_end = (int)((long long)n * (c + 1) / fill_chunks);
+    }
+    run_chunks(pool, chunk_fill, fill, sizeof(fill[0]), fill_chunks);
+
+    free(local);
+    free(start);
+    return 0;
+}
+
+/**
+ * @brief Sorts an array of n elements using counting sort over [min, max].
+ *
+ * Falls back to radix_sort_lsd() if the key range is too large relative to n.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void counting_sort_range(int *arr, int n) {
+    size_t max_range = (size_t)n * COUNTING_SORT_RANGE_RATIO;
+    if (max_range < COUNTING_SORT_RANGE_MIN)
+        max_range = COUNTING_SORT_RANGE_MIN;
+
+    if (counting_sort_range_max(arr, n, max_range) != 0) {
+        radix_sort_lsd(arr, n);
+    }
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Driver code to demonstrate counting_sort_range and counting_sort_range_max.
+ *
+ * Defaults SORT_THREADS to 4 so that the per-thread histograms and the parallel rewrite run
+ * even on a single-core machine.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    setenv("SORT_THREADS", "4", 0);
+
+    int arr1[] = {4, -2, 2, 8, -3, 3, 1};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    counting_sort_range(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-3, -2, 1, 2, 3, 4, 8};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    // A huge range is refused by the capped version and handled by the fallback
+    int arr2[] = {INT_MAX, 0, INT_MIN, 7};
+    assert(counting_sort_range_max(arr2, 4, 1 << 20) == -1);
+    assert(arr2[0] == INT_MAX && arr2[2] == INT_MIN);
+    counting_sort_range(arr2, 4);
+    assert(arr2[0] == INT_MIN && arr2[1] == 0 && arr2[2] == 7 && arr2[3] == INT_MAX);
+
+    // Large values in a narrow band need only a narrow table
+    int arr3[] = {2000000003, 2000000001, 2000000002, 2000000001};
+    assert(counting_sort_range_max(arr3, 4, 3) == 0);
+    assert(arr3[0] == 2000000001 && arr3[1] == 2000000001 && arr3[3] == 2000000003);
+
+    enum { N = 1000000 };
+    static int big[N];
+    srand(23);
+    for (int range = 1; range <= 4 * N; range *= 16) {
+        long long sum_before = 0, sum_after = 0;
+        for (int i = 0; i < N; i++) {
+            big[i] = (int)(((unsigned)rand() << 16 ^ (unsigned)rand()) % range) - range / 2;
+            sum_before += big[i];
+        }
+        counting_sort_range(big, N);
+        for (int i = 0; i < N; i++) {
+            sum_after += big[i];
+            if (i > 0) {
+                assert(big[i - 1] <= big[i]);
+            }
+        }
+        assert(sum_before == sum_after);
+    }
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -25,6 +25,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "sort.h"
+
 /**
  * @brief Find the maximum value in an array.
  * 
@@ -32,7 +34,7 @@
  * @param n The size of the array.
  * @return The maximum value in the array.
  */
-int findMax(int arr[], int n) {
+static int findMax(int arr[], int n) {
     int max = arr[0];
     for (int i = 1; i < n; i++) {
         if (arr[i] > max) {
@@ -49,7 +51,7 @@ int findMax(int arr[], int n) {
  * @param max The maximum value in the input array.
  * @param i The current index.
  */
-void accumulateCounts(int count[], int max, int i) {
+static void accumulateCounts(int count[], int max, int i) {
     if (i > max) {
         return;
     }
@@ -66,7 +68,7 @@ void accumulateCounts(int count[], int max, int i) {
  * @param n The size of the input array.
  * @param i The current index.
  */
-void placeElements(int arr[], int output[], int count[], int n, int i) {
+static void placeElements(int arr[], int output[], int count[], int n, int i) {
     if (i < 0) {
         return;
     }
@@ -81,7 +83,7 @@ void placeElements(int arr[], int output[], int count[], int n, int i) {
  * @param arr The array to be sorted.
  * @param n The size of the array.
  */
-void countingSort(int arr[], int n) {
+void counting_sort_recursive(int arr[], int n) {
     int max = findMax(arr, n);
     int *count = (int *)calloc(max + 1, sizeof(int));
     int *output = (int *)malloc(n * sizeof(int));
@@ -108,23 +110,11 @@ void countingSort(int arr[], int n) {
     free(output);
 }
 
+#ifdef SORT_DEMO
 /**
- * @brief Print an array.
+ * @brief Driver code to demonstrate the counting_sort_recursive function.
  * 
- * @param arr The array to be printed.
- * @param n The size of the array.
- */
-void printArray(int arr[], int n) {
-    for (int i = 0; i < n; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
-
-/**
- * @brief Driver code to demonstrate the countingSort function.
- * 
- * This function creates multiple test cases and calls the countingSort function to sort arrays.
+ * This function creates multiple test cases and calls the counting_sort_recursive function to sort arrays.
  * It then prints and verifies the sorted arrays using assertions.
  * 
  * @return 0 on successful execution.
@@ -132,8 +122,8 @@ void printArray(int arr[], int n) {
 int main() {
     int arr1[] = {4, 2, 2, 8, 3, 3, 1};
     int n1 = sizeof(arr1) / sizeof(arr1[0]);
-    countingSort(arr1, n1);
-    printArray(arr1, n1);
+    counting_sort_recursive(arr1, n1);
+    sort_print_array(arr1, n1);
     int expected1[] = {1, 2, 2, 3, 3, 4, 8};
     for (int i = 0; i < n1; i++) {
         assert(arr1[i] == expected1[i]);
@@ -141,8 +131,8 @@ int main() {
 
     int arr2[] = {7, 1, 3, 9, 7, 6, 2};
     int n2 = sizeof(arr2) / sizeof(arr2[0]);
-    countingSort(arr2, n2);
-    printArray(arr2, n2);
+    counting_sort_recursive(arr2, n2);
+    sort_print_array(arr2, n2);
     int expected2[] = {1, 2, 3, 6, 7, 7, 9};
     for (int i = 0; i < n2; i++) {
         assert(arr2[i] == expected2[i]);
@@ -150,8 +140,8 @@ int main() {
 
     int arr3[] = {4, 3, 2, 1, 4, 3, 2, 1};
     int n3 = sizeof(arr3) / sizeof(arr3[0]);
-    countingSort(arr3, n3);
-    printArray(arr3, n3);
+    counting_sort_recursive(arr3, n3);
+    sort_print_array(arr3, n3);
     int expected3[] = {1, 1, 2, 2, 3, 3, 4, 4};
     for (int i = 0; i < n3; i++) {
         assert(arr3[i] == expected3[i]);
@@ -161,7 +151,4 @@ int main() {
 
     return 0; // Return 0 to indicate successful execution
 }
-
-
-
-
+#endif /* SORT_DEMO */
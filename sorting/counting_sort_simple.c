@@ -50,6 +50,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "sort.h"
+
 /**
  * @brief Find the maximum value in an array.
  * 
@@ -57,7 +59,7 @@
  * @param n The size of the array.
  * @return The maximum value in the array.
  */
-int findMax(int arr[], int n) {
+static int findMax(int arr[], int n) {
     int max = arr[0]; // Initialize max with the first element
     for (int i = 1; i < n; i++) { // Iterate through the array
         if (arr[i] > max) { // Update max if current element is greater
@@ -73,7 +75,7 @@ int findMax(int arr[], int n) {
  * @param arr The array to be sorted.
  * @param n The size of the array.
  */
-void countingSort(int arr[], int n) {
+void counting_sort_simple(int arr[], int n) {
     int max = findMax(arr, n); // Find the maximum value in the array
     int *count = (int *)calloc(max + 1, sizeof(int)); // Initialize count array
     int *output = (int *)malloc(n * sizeof(int)); // Initialize output array
@@ -103,23 +105,11 @@ void countingSort(int arr[], int n) {
     free(output); // Free the allocated memory for output array
 }
 
+#ifdef SORT_DEMO
 /**
- * @brief Print an array.
- * 
- * @param arr The array to be printed.
- * @param n The size of the array.
- */
-void printArray(int arr[], int n) {
-    for (int i = 0; i < n; i++) { // Iterate through the array
-        printf("%d ", arr[i]); // Print each element
-    }
-    printf("\n"); // Print a new line
-}
-
-/**
- * @brief Driver code to demonstrate the countingSort function.
+ * @brief Driver code to demonstrate the counting_sort_simple function.
  * 
- * This function creates multiple test cases and calls the countingSort function to sort arrays.
+ * This function creates multiple test cases and calls the counting_sort_simple function to sort arrays.
  * It then prints and verifies the sorted arrays using assertions.
  * 
  * @return 0 on successful execution.
@@ -127,8 +117,8 @@ void printArray(int arr[], int n) {
 int main() {
     int arr1[] = {4, 2, 2, 8, 3, 3, 1}; // Test case 1
     int n1 = sizeof(arr1) / sizeof(arr1[0]); // Calculate the size of the array
-    countingSort(arr1, n1); // Sort the array
-    printArray(arr1, n1); // Print the sorted array
+    counting_sort_simple(arr1, n1); // Sort the array
+    sort_print_array(arr1, n1); // Print the sorted array
     int expected1[] = {1, 2, 2, 3, 3, 4, 8}; // Expected result
     for (int i = 0; i < n1; i++) {
         assert(arr1[i] == expected1[i]); // Assert to verify the result
@@ -136,8 +126,8 @@ int main() {
 
     int arr2[] = {7, 1, 3, 9, 7, 6, 2}; // Test case 2
     int n2 = sizeof(arr2) / sizeof(arr2[0]); // Calculate the size of the array
-    countingSort(arr2, n2); // Sort the array
-    printArray(arr2, n2); // Print the sorted array
+    counting_sort_simple(arr2, n2); // Sort the array
+    sort_print_array(arr2, n2); // Print the sorted array
     int expected2[] = {1, 2, 3, 6, 7, 7, 9}; // Expected result
     for (int i = 0; i < n2; i++) {
         assert(arr2[i] == expected2[i]); // Assert to verify the result
@@ -145,8 +135,8 @@ int main() {
 
     int arr3[] = {4, 3, 2, 1, 4, 3, 2, 1}; // Test case 3
     int n3 = sizeof(arr3) / sizeof(arr3[0]); // Calculate the size of the array
-    countingSort(arr3, n3); // Sort the array
-    printArray(arr3, n3); // Print the sorted array
+    counting_sort_simple(arr3, n3); // Sort the array
+    sort_print_array(arr3, n3); // Print the sorted array
     int expected3[] = {1, 1, 2, 2, 3, 3, 4, 4}; // Expected result
     for (int i = 0; i < n3; i++) {
         assert(arr3[i] == expected3[i]); // Assert to verify the result
@@ -156,3 +146,4 @@ int main() {
 
     return 0; // Return 0 to indicate successful execution
 }
+#endif /* SORT_DEMO */
@@ -0,0 +1,197 @@
+/**
+ * @file heap_sort_bottom_up.c
+ * @brief Implementation of Bottom-Up Heap Sort on binary, 4-ary or 8-ary heaps.
+ *
+ * @details
+ * heap_sort_simple() restores the heap with the textbook sift-down: at every level it compares
+ * the two children with each other and then with the element being sifted, so about
+ * 2 log2(n) comparisons per extraction, and the element almost always ends up near the
+ * bottom anyway. This version uses two classic improvements:
+ * - **Floyd's bottom-up sift**: the hole left at the top is first moved down to a leaf along
+ *   the path of larger children, which only compares children with each other. The element
+ *   is then placed in the hole and sifted up, which usually stops after a level or two. This
+ *   roughly halves the comparisons, and the descent has no early exit to mispredict.
+ * - **d-ary layout**: with 4 or 8 children per node the heap is half or a third as deep, and
+ *   the children of a node are d consecutive ints (16 or 32 bytes), so each level of the
+ *   descent reads one or two cache lines instead of jumping to a new line per level. The
+ *   extra comparisons among siblings are cheap next to the cache misses they replace once the
+ *   array outgrows the cache.
+ *
+ * heap_sort_dary() selects the arity; heap_sort_bottom_up() uses HEAP_SORT_DEFAULT_ARITY,
+ * and it is the worst-case fallback of the introsort-style sorts in this directory.
+ *
+ * @section Performance
+ * - Time Complexity: O(n log n) in every case.
+ * - Space Complexity: O(1)
+ *
+ * Heap sort is not stable.
+ *
+ * @reference
+ * - Robert W. Floyd, "Algorithm 245: Treesort 3", 1964.
+ * - Ingo Wegener, "Bottom-up-heapsort, a new variant of heapsort beating, on an average,
+ *   quicksort (if n is not very small)", 1993.
+ * - Anthony LaMarca and Richard E. Ladner, "The Influence of Caches on the Performance of
+ *   Heaps", 1996.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Arity used by heap_sort_bottom_up(). */
+#define HEAP_SORT_DEFAULT_ARITY 4
+
+#define MAX_HEAP_ABOVE(a, b) ((a) > (b))
+
+SORT_DEFINE_INT_HEAP_(max_heap, MAX_HEAP_ABOVE)
+
+/**
+ * @brief Heap sort on a d-ary max-heap; inlined once per arity so that d is a constant.
+ */
+static inline void heap_sort_arity(int *arr, int n, const int d) {
+    if (n < 2) {
+        return;
+    }
+    // Build the heap bottom-up, starting from the last node that has children
+    for (int i = (n - 2) / d; i >= 0; i--) {
+        max_heap_sift_bottom_up(arr, n, i, arr[i], d);
+    }
+    // Move the maximum behind the heap and re-insert the element it displaces
+    for (int end = n - 1; end > 0; end--) {
+        int x = arr[end];
+        arr[end] = arr[0];
+        max_heap_sift_bottom_up(arr, end, 0, x, d);
+    }
+}
+
+static void heap_sort_2(int *arr, int n) {
+    heap_sort_arity(arr, n, 2);
+}
+
+static void heap_sort_4(int *arr, int n) {
+    heap_sort_arity(arr, n, 4);
+}
+
+static void heap_sort_8(int *arr, int n) {
+    heap_sort_arity(arr, n, 8);
+}
+
+/**
+ * @brief Sorts an array of n elements using bottom-up heap sort on a heap of the given arity.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param arity Children per node: 2, 4 or 8.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int heap_sort_dary(int *arr, int n, int arity) {
+    if (n < 0 || (arr == NULL && n > 0)) {
+        return -1;
+    }
+    switch (arity) {
+    case 2:
+        heap_sort_2(arr, n);
+        return 0;
+    case 4:
+        heap_sort_4(arr, n);
+        return 0;
+    case 8:
+        heap_sort_8(arr, n);
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Sorts an array of n elements using bottom-up heap sort on a 4-ary heap.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void heap_sort_bottom_up(int *arr, int n) {
+    heap_sort_dary(arr, n, HEAP_SORT_DEFAULT_ARITY);
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Driver code to demonstrate heap_sort_bottom_up and heap_sort_dary.
+ *
+ * Checks every arity against qsort() on many sizes and prints how long heap_sort_simple()
+ * and each arity take on the same random array.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {12, 11, 13, 5, 6, 7};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    heap_sort_bottom_up(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {5, 6, 7, 11, 12, 13};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+    assert(heap_sort_dary(arr1, n1, 3) == -1);
+    assert(heap_sort_dary(NULL, 0, 8) == 0);
+
+    const int arities[] = {2, 4, 8};
+    enum { SMALL = 200 };
+    int arr[SMALL], ref[SMALL];
+    srand(47);
+    for (int a = 0; a < 3; a++) {
+        for (int n = 0; n <= SMALL; n++) {
+            for (int i = 0; i < n; i++) {
+                arr[i] = rand() % (n % 2 ? 5 : 1000) - 2;
+            }
+            memcpy(ref, arr, n * sizeof(int));
+            assert(heap_sort_dary(arr, n, arities[a]) == 0);
+            qsort(ref, n, sizeof(int), compare_ints);
+            assert(memcmp(arr, ref, n * sizeof(int)) == 0);
+        }
+    }
+
+    enum { N = 1000000 };
+    int *a = malloc(N * sizeof(int));
+    int *b = malloc(N * sizeof(int));
+    int *sorted = malloc(N * sizeof(int));
+    assert(a != NULL && b != NULL && sorted != NULL);
+    for (int i = 0; i < N; i++) {
+        a[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+    }
+    memcpy(sorted, a, N * sizeof(int));
+    clock_t start = clock();
+    heap_sort_simple(sorted, N);
+    printf("%d ints: heap_sort_simple %.3fs", N, seconds_since(start));
+    for (int k = 0; k < 3; k++) {
+        memcpy(b, a, N * sizeof(int));
+        start = clock();
+        heap_sort_dary(b, N, arities[k]);
+        printf(", %d-ary bottom-up %.3fs", arities[k], seconds_since(start));
+        assert(memcmp(b, sorted, N * sizeof(int)) == 0);
+    }
+    printf("\n");
+    free(a);
+    free(b);
+    free(sorted);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
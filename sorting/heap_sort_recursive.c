@@ -27,17 +27,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
-/**
- * @brief Swap two elements in an array.
- * 
- * @param a Pointer to the first element.
- * @param b Pointer to the second element.
- */
-void swap(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
+#include "sort.h"
+#include "sort_internal.h"
 
 /**
  * @brief Heapify a subtree rooted with node i which is an index in arr[]. n is the size of the heap.
@@ -46,7 +37,7 @@ void swap(int *a, int *b) {
  * @param n The size of the heap.
  * @param i The root index of the subtree to heapify.
  */
-void heapify(int arr[], int n, int i) {
+static void heapify(int arr[], int n, int i) {
     int largest = i; // Initialize largest as root
     int left = 2 * i + 1; // left = 2*i + 1
     int right = 2 * i + 2; // right = 2*i + 2
@@ -61,7 +52,7 @@ void heapify(int arr[], int n, int i) {
 
     // If largest is not root
     if (largest != i) {
-        swap(&arr[i], &arr[largest]);
+        sort_swap(&arr[i], &arr[largest]);
 
         // Recursively heapify the affected sub-tree
         heapify(arr, n, largest);
@@ -74,7 +65,7 @@ void heapify(int arr[], int n, int i) {
  * @param arr The array to be sorted.
  * @param n The size of the array.
  */
-void heapSort(int arr[], int n) {
+void heap_sort_recursive(int arr[], int n) {
     // Build heap (rearrange array)
     for (int i = n / 2 - 1; i >= 0; i--)
         heapify(arr, n, i);
@@ -82,29 +73,18 @@ void heapSort(int arr[], int n) {
     // One by one extract an element from heap
     for (int i = n - 1; i > 0; i--) {
         // Move current root to end
-        swap(&arr[0], &arr[i]);
+        sort_swap(&arr[0], &arr[i]);
 
         // Call max heapify on the reduced heap
         heapify(arr, i, 0);
     }
 }
 
+#ifdef SORT_DEMO
 /**
- * @brief Print an array.
+ * @brief Driver code to demonstrate the heap_sort_recursive function.
  * 
- * @param arr The array to be printed.
- * @param n The size of the array.
- */
-void printArray(int arr[], int n) {
-    for (int i = 0; i < n; i++)
-        printf("%d ", arr[i]);
-    printf("\n");
-}
-
-/**
- * @brief Driver code to demonstrate the heapSort function.
- * 
- * This function creates multiple test cases and calls the heapSort function to sort arrays.
+ * This function creates multiple test cases and calls the heap_sort_recursive function to sort arrays.
  * It then prints and verifies the sorted arrays using assertions.
  * 
  * @return 0 on successful execution.
@@ -112,8 +92,8 @@ void printArray(int arr[], int n) {
 int main() {
     int arr1[] = {12, 11, 13, 5, 6, 7};
     int n1 = sizeof(arr1) / sizeof(arr1[0]);
-    heapSort(arr1, n1);
-    printArray(arr1, n1);
+    heap_sort_recursive(arr1, n1);
+    sort_print_array(arr1, n1);
     int expected1[] = {5, 6, 7, 11, 12, 13};
     for (int i = 0; i < n1; i++) {
         assert(arr1[i] == expected1[i]);
@@ -121,8 +101,8 @@ int main() {
 
     int arr2[] = {4, 10, 3, 5, 1};
     int n2 = sizeof(arr2) / sizeof(arr2[0]);
-    heapSort(arr2, n2);
-    printArray(arr2, n2);
+    heap_sort_recursive(arr2, n2);
+    sort_print_array(arr2, n2);
     int expected2[] = {1, 3, 4, 5, 10};
     for (int i = 0; i < n2; i++) {
         assert(arr2[i] == expected2[i]);
@@ -130,8 +110,8 @@ int main() {
 
     int arr3[] = {4, 6, 3, 2, 8, 7, 2, 1};
     int n3 = sizeof(arr3) / sizeof(arr3[0]);
-    heapSort(arr3, n3);
-    printArray(arr3, n3);
+    heap_sort_recursive(arr3, n3);
+    sort_print_array(arr3, n3);
     int expected3[] = {1, 2, 2, 3, 4, 6, 7, 8};
     for (int i = 0; i < n3; i++) {
         assert(arr3[i] == expected3[i]);
@@ -141,6 +121,4 @@ int main() {
 
     return 0; // Return 0 to indicate successful execution
 }
-
-
-
+#endif /* SORT_DEMO */
@@ -26,20 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param length The number of elements in the array.
- */
-void printf_array(int *arr, int length) {
-    for (int i = 0; i < length; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Sorts an array using insertion sort algorithm.
@@ -51,7 +38,7 @@ void printf_array(int *arr, int length) {
  * @param arr The array to be sorted.
  * @param n The number of elements in the array.
  */
-void insertion_sort(int *arr, int n) {
+void insertion_sort_iterative(int *arr, int n) {
     for (int i = 1; i < n; i++) {
         int key = arr[i]; // The element to be positioned
         int j = i - 1;
@@ -65,6 +52,7 @@ void insertion_sort(int *arr, int n) {
     }
 }
 
+#ifdef SORT_DEMO
 int main() {
     // Test case 1: Regular unsorted array
     int unsorted_array1[5] = {50, 20, 40, 10, 5};
@@ -87,25 +75,26 @@ int main() {
     int n5 = sizeof(duplicate_array) / sizeof(duplicate_array[0]);
 
     // Sort and print all test cases
-    insertion_sort(unsorted_array1, n1);
+    insertion_sort_iterative(unsorted_array1, n1);
     printf("Sorted array 1: ");
-    printf_array(unsorted_array1, n1);
+    sort_print_array(unsorted_array1, n1);
 
-    insertion_sort(unsorted_array2, n2);
+    insertion_sort_iterative(unsorted_array2, n2);
     printf("Sorted array 2: ");
-    printf_array(unsorted_array2, n2);
+    sort_print_array(unsorted_array2, n2);
 
-    insertion_sort(sorted_array, n3);
+    insertion_sort_iterative(sorted_array, n3);
     printf("Sorted array 3: ");
-    printf_array(sorted_array, n3);
+    sort_print_array(sorted_array, n3);
 
-    insertion_sort(reverse_sorted_array, n4);
+    insertion_sort_iterative(reverse_sorted_array, n4);
     printf("Sorted array 4: ");
-    printf_array(reverse_sorted_array, n4);
+    sort_print_array(reverse_sorted_array, n4);
 
-    insertion_sort(duplicate_array, n5);
+    insertion_sort_iterative(duplicate_array, n5);
     printf("Sorted array 5: ");
-    printf_array(duplicate_array, n5);
+    sort_print_array(duplicate_array, n5);
 
     return 0;
 }
+#endif /* SORT_DEMO */
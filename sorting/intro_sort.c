@@ -0,0 +1,183 @@
+/**
+ * @file intro_sort.c
+ * @brief Implementation of the Introsort (introspective sort) Algorithm.
+ *
+ * @details
+ * Introsort is a hybrid of three algorithms that are already part of this library:
+ * - It starts out as the three-way quick sort from quick_sort_three_way.c, using a
+ *   median-of-three pivot so that sorted and reverse-sorted input split evenly.
+ * - If the recursion gets deeper than 2 * log2(n), the current segment is handed to
+ *   heap_sort_bottom_up(), which caps the worst case at O(n log n).
+ * - Segments of at most INTRO_SORT_THRESHOLD elements are finished with
+ *   insertion_sort_iterative(), which is faster than either of the above on tiny inputs.
+ *
+ * The recursion always descends into the smaller side and loops on the larger one, so the
+ * stack depth stays O(log n) even before the depth limit kicks in.
+ *
+ * @section Performance
+ * - Best Case Time Complexity: O(n) - when all keys are equal (a single three-way partition).
+ * - Average Case Time Complexity: O(n log n)
+ * - Worst Case Time Complexity: O(n log n) - guaranteed by the heap sort fallback.
+ * - Space Complexity: O(log n) - due to the recursion stack.
+ *
+ * @reference
+ * - David R. Musser, "Introspective Sorting and Selection Algorithms", 1997.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Segments of this size or smaller are finished with insertion sort. */
+#define INTRO_SORT_THRESHOLD 16
+
+/**
+ * @brief Moves the median of arr[low], arr[mid] and arr[high] to arr[low].
+ *
+ * sort_three_way_partition() uses arr[low] as its pivot, so this is all that is needed
+ * to turn it into a median-of-three partition.
+ *
+ * @param arr The array.
+ * @param low The starting index of the segment.
+ * @param high The ending index of the segment.
+ */
+static void median_of_three_to_low(int *arr, int low, int high) {
+    int mid = low + (high - low) / 2;
+
+    // Order the three samples so that arr[low] <= arr[mid] <= arr[high]
+    if (arr[mid] < arr[low])
+        sort_swap(&arr[mid], &arr[low]);
+    if (arr[high] < arr[low])
+        sort_swap(&arr[high], &arr[low]);
+    if (arr[high] < arr[mid])
+        sort_swap(&arr[high], &arr[mid]);
+
+    // The median is now at mid; make it the pivot
+    sort_swap(&arr[low], &arr[mid]);
+}
+
+/**
+ * @brief Sorts arr[low..high] with introsort.
+ *
+ * @param arr The array to be sorted.
+ * @param low The starting index of the segment.
+ * @param high The ending index of the segment.
+ * @param depth_limit Number of partitioning levels left before switching to heap sort.
+ */
+static void intro_sort_range(int *arr, int low, int high, int depth_limit) {
+    while (high - low + 1 > INTRO_SORT_THRESHOLD) {
+        if (depth_limit == 0) {
+            // Too many unbalanced partitions: fall back to heap sort for this segment
+            heap_sort_bottom_up(arr + low, high - low + 1);
+            return;
+        }
+        depth_limit--;
+
+        int lt, gt;
+        median_of_three_to_low(arr, low, high);
+        sort_three_way_partition(arr, low, high, &lt, &gt);
+
+        // Recurse into the smaller side, loop on the larger one
+        if (lt - low < high - gt) {
+            intro_sort_range(arr, low, lt - 1, depth_limit);
+            low = gt + 1;
+        } else {
+            intro_sort_range(arr, gt + 1, high, depth_limit);
+            high = lt - 1;
+        }
+    }
+
+    if (high > low) {
+        insertion_sort_iterative(arr + low, high - low + 1);
+    }
+}
+
+/**
+ * @brief Sorts an array of n elements using introsort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void intro_sort(int *arr, int n) {
+    // Depth limit of 2 * floor(log2(n)), as suggested by Musser
+    int depth_limit = 0;
+    for (int m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+    intro_sort_range(arr, 0, n - 1, depth_limit);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Checks that an array is sorted in non-decreasing order.
+ *
+ * @param arr The array to check.
+ * @param n The size of the array.
+ */
+static void assert_sorted(const int *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        assert(arr[i - 1] <= arr[i]);
+    }
+}
+
+/**
+ * @brief Driver code to demonstrate the intro_sort function.
+ *
+ * Sorts small fixed inputs against expected results, then larger sorted, reverse-sorted,
+ * all-equal and random inputs that would hurt a plain quick sort.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {4, 9, 4, 4, 2, 3, 4, 9, 2, 9};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    intro_sort(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {2, 2, 3, 4, 4, 4, 4, 9, 9, 9};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    int arr2[] = {-1, -3, -2, -5, -4};
+    int n2 = sizeof(arr2) / sizeof(arr2[0]);
+    intro_sort(arr2, n2);
+    sort_print_array(arr2, n2);
+    int expected2[] = {-5, -4, -3, -2, -1};
+    for (int i = 0; i < n2; i++) {
+        assert(arr2[i] == expected2[i]);
+    }
+
+    enum { N = 10000 };
+    static int big[N];
+
+    for (int i = 0; i < N; i++) big[i] = i;         // Already sorted
+    intro_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = N - i;     // Reverse sorted
+    intro_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = 7;         // All equal
+    intro_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i % 2 ? i : N - i; // Organ-pipe style
+    intro_sort(big, N);
+    assert_sorted(big, N);
+
+    srand(1);
+    for (int i = 0; i < N; i++) big[i] = rand() - RAND_MAX / 2; // Random, with negatives
+    intro_sort(big, N);
+    assert_sorted(big, N);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,295 @@
+/**
+ * @file merge_sort_parallel.c
+ * @brief Implementation of a Parallel Merge Sort Algorithm.
+ *
+ * @details
+ * The two recursive halves of merge sort are independent, so they are forked onto the
+ * work-stealing pool from sort_pool.c: the left half is spawned as a task and the right half
+ * is sorted by the current thread, after which the two are joined and merged. Idle threads
+ * steal the oldest (largest) pending halves, which spreads the work with little coordination.
+ *
+ * - **Grain size**: segments of MERGE_SORT_PARALLEL_GRAIN elements or fewer are sorted with
+ *   the sequential merge_sort_scratch(), using the matching slice of the shared buffer as its
+ *   scratch space; below that size task overhead outweighs the gain.
+ * - **Single buffer**: one auxiliary array of n elements is allocated up front. Each level
+ *   merges from one buffer into the other, alternating direction, instead of allocating
+ *   temporary arrays in every merge.
+ * - **Parallel merge**: at the top levels a single sequential merge would leave all but one
+ *   thread idle, so merges of at least MERGE_SORT_PARALLEL_MERGE_MIN elements are split into
+ *   independent pieces. For an output position k, the co-rank (i, j) with i + j = k is found by
+ *   binary search such that the first k outputs are exactly A[0..i) and B[0..j). The pieces
+ *   between consecutive split points are merged concurrently.
+ *
+ * The thread count comes from sort_pool_default() (one per CPU, or SORT_THREADS).
+ * The sort is stable.
+ *
+ * @section Performance
+ * - Work: O(n log n)
+ * - Span: O(log^3 n) with parallel merging (O(n) without it)
+ * - Space Complexity: O(n) - one auxiliary array, plus O(log n) stack per thread.
+ *
+ * @reference
+ * - Christian Siebert and Jesper Larsson Traff, "Perfectly load-balanced, optimal, stable,
+ *   parallel merge", 2013 (co-ranking).
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_pool.h"
+
+/** Segments of this size or smaller are sorted sequentially. */
+#define MERGE_SORT_PARALLEL_GRAIN 8192
+/** Merges producing at least this many elements are split across threads. */
+#define MERGE_SORT_PARALLEL_MERGE_MIN 65536
+/** Upper bound on the number of pieces a single merge is split into. */
+#define MERGE_SORT_PARALLEL_MAX_PIECES 64
+
+/**
+ * @brief Arguments of one recursive sorting task.
+ */
+typedef struct {
+    sort_pool_t *pool;
+    int *a;     /**< Segment to sort. */
+    int *b;     /**< Scratch segment of the same size. */
+    int n;      /**< Number of elements. */
+    int into_b; /**< Nonzero if the sorted result must end up in b instead of a. */
+} msort_job_t;
+
+/**
+ * @brief Arguments of one piece of a parallel merge.
+ */
+typedef struct {
+    const int *a;
+    int m;
+    const int *b;
+    int n;
+    int *dst;
+    int k_begin; /**< First output position of this piece. */
+    int k_end;   /**< One past the last output position of this piece. */
+} merge_piece_t;
+
+/**
+ * @brief Merges sorted a[0..m) and b[0..n) into dst, taking from a first on ties.
+ */
+static void merge_sequential(const int *a, int m, const int *b, int n, int *dst) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < m && j < n) {
+        if (a[i] <= b[j]) {
+            dst[k++] = a[i++];
+        } else {
+            dst[k++] = b[j++];
+        }
+    }
+    while (i < m) {
+        dst[k++] = a[i++];
+    }
+    while (j < n) {
+        dst[k++] = b[j++];
+    }
+}
+
+/**
+ * @brief Finds how many elements of a are among the first k outputs of the stable merge.
+ *
+ * @param k Output position, 0 <= k <= m + n.
+ * @param a First sorted input.
+ * @param m Size of a.
+ * @param b Second sorted input.
+ * @param n Size of b.
+ * @return i such that the first k outputs are a[0..i) and b[0..k-i).
+ */
+static int co_rank(int k, const int *a, int m, const int *b, int n) {
+    int i = k < m ? k : m;
+    int j = k - i;
+    int i_low = k - n > 0 ? k - n : 0;
+    int j_low = k - m > 0 ? k - m : 0;
+
+    for (;;) {
+        if (i > 0 && j < n && a[i - 1] > b[j]) {
+            // Too many elements taken from a
+            int delta = (i - i_low + 1) / 2;
+            j_low = j;
+            i -= delta;
+            j += delta;
+        } else if (j > 0 && i < m && b[j - 1] >= a[i]) {
+            // Too many elements taken from b (ties belong to a)
+            int delta = (j - j_low + 1) / 2;
+            i_low = i;
+            i += delta;
+            j -= delta;
+        } else {
+            return i;
+        }
+    }
+}
+
+/**
+ * @brief Task body: merges the output range [k_begin, k_end) of a piece.
+ */
+static void merge_piece(void *arg) {
+    const merge_piece_t *p = arg;
+    int i_begin = co_rank(p->k_begin, p->a, p->m, p->b, p->n);
+    int i_end = co_rank(p->k_end, p->a, p->m, p->b, p->n);
+    int j_begin = p->k_begin - i_begin;
+    int j_end = p->k_end - i_end;
+
+    merge_sequential(p->a + i_begin, i_end - i_begin, p->b + j_begin, j_end - j_begin,
+                     p->dst + p->k_begin);
+}
+
+/**
+ * @brief Merges sorted a[0..m) and b[0..n) into dst, in parallel when the merge is large.
+ */
+static void merge_parallel(sort_pool_t *pool, const int *a, int m, const int *b, int n, int *dst) {
+    int total = m + n;
+    int threads = sort_pool_threads(pool);
+
+    if (threads == 1 || total < MERGE_SORT_PARALLEL_MERGE_MIN) {
+        merge_sequential(a, m, b, n, dst);
+        return;
+    }
+
+    // A few pieces per thread so that stealing can even out the load
+    int pieces = 4 * threads;
+    if (pieces > MERGE_SORT_PARALLEL_MAX_PIECES)
+        pieces = MERGE_SORT_PARALLEL_MAX_PIECES;
+    if (pieces > total / MERGE_SORT_PARALLEL_GRAIN)
+        pieces = total / MERGE_SORT_PARALLEL_GRAIN;
+
+    merge_piece_t piece[MERGE_SORT_PARALLEL_MAX_PIECES];
+    sort_task_t task[MERGE_SORT_PARALLEL_MAX_PIECES];
+
+    for (int p = 0; p < pieces; p++) {
+        piece[p].a = a;
+        piece[p].m = m;
+        piece[p].b = b;
+        piece[p].n = n;
+        piece[p].dst = dst;
+        piece[p].k_begin = (int)((long long)total * p / pieces);
+        piece[p].k_end = (int)((long long)total * (p + 1) / pieces);
+    }
+    for (int p = 1; p < pieces; p++) {
+        sort_pool_spawn(pool, &task[p], merge_piece, &piece[p]);
+    }
+    merge_piece(&piece[0]);
+    for (int p = pieces - 1; p >= 1; p--) {
+        sort_pool_wait(pool, &task[p]);
+    }
+}
+
+/**
+ * @brief Task body: sorts job->a[0..n), leaving the result in a or b as requested.
+ */
+static void msort(void *arg) {
+    const msort_job_t *job = arg;
+
+    if (job->n <= MERGE_SORT_PARALLEL_GRAIN) {
+        merge_sort_scratch(job->a, job->n, job->b);
+        if (job->into_b) {
+            memcpy(job->b, job->a, job->n * sizeof(int));
+        }
+        return;
+    }
+
+    // Both halves put their result in the other buffer, which is then merged back
+    int half = job->n / 2;
+    msort_job_t left = {job->pool, job->a, job->b, half, !job->into_b};
+    msort_job_t right = {job->pool, job->a + half, job->b + half, job->n - half, !job->into_b};
+    sort_task_t task;
+
+    sort_pool_spawn(job->pool, &task, msort, &left);
+    msort(&right);
+    sort_pool_wait(job->pool, &task);
+
+    const int *src = job->into_b ? job->a : job->b;
+    int *dst = job->into_b ? job->b : job->a;
+    merge_parallel(job->pool, src, half, src + half, job->n - half, dst);
+}
+
+/**
+ * @brief Sorts an array of n elements using parallel merge sort.
+ *
+ * Falls back to merge_sort_buffered() if the array is small or the auxiliary buffer cannot
+ * be allocated.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void merge_sort_parallel(int *arr, int n) {
+    int *aux = NULL;
+
+    if (n > MERGE_SORT_PARALLEL_GRAIN) {
+        aux = malloc(n * sizeof(int));
+    }
+    if (aux == NULL) {
+        merge_sort_buffered(arr, n);
+        return;
+    }
+
+    msort_job_t job = {sort_pool_default(), arr, aux, n, 0};
+    msort(&job);
+    free(aux);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Driver code to demonstrate the merge_sort_parallel function.
+ *
+ * Checks small inputs, which stay on the sequential path, and large ones, which a
+ * four-thread pool (SORT_THREADS, if set, wins) splits into parallel merges.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    setenv("SORT_THREADS", "4", 0);
+
+    int arr1[] = {64, 34, 25, 12, 22, 11, 90};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    merge_sort_parallel(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {11, 12, 22, 25, 34, 64, 90};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    enum { N = 1000000 };
+    int *big = malloc(N * sizeof(int));
+    assert(big != NULL);
+
+    for (int i = 0; i < N; i++) big[i] = N - i;     // Reverse sorted
+    merge_sort_parallel(big, N);
+    for (int i = 0; i < N; i++) {
+        assert(big[i] == i + 1);
+    }
+
+    srand(5);
+    long long sum_before = 0, sum_after = 0;
+    for (int i = 0; i < N; i++) {                   // Random with many duplicates
+        big[i] = rand() % 1000 - 500;
+        sum_before += big[i];
+    }
+    merge_sort_parallel(big, N);
+    for (int i = 0; i < N; i++) {
+        sum_after += big[i];
+        if (i > 0) {
+            assert(big[i - 1] <= big[i]);
+        }
+    }
+    assert(sum_before == sum_after);
+    free(big);
+
+    printf("Sorted with %d threads.\n", sort_pool_threads(sort_pool_default()));
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -15,6 +15,9 @@
  * It is efficient for sorting large data sets and is widely used in various applications.
  * However, it requires additional space for the temporary arrays used during the merging process.
  *
+ * Ranges of at most sort_network_cutoff() elements are sorted with sort_network() instead of
+ * being split further.
+ *
  * @section Steps of Merge Sort
  * 1. Divide the unsorted array into two halves.
  *    - This is done recursively until each subarray contains a single element.
@@ -41,7 +44,7 @@
  * @code
  * int arr[] = {64, 34, 25, 12, 22, 11, 90};
  * int n = sizeof(arr) / sizeof(arr[0]);
- * mergeSort(arr, 0, n - 1);
+ * merge_sort_simple(arr, n);
  * @endcode
  *
  * This will sort the array in ascending order.
@@ -60,20 +63,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param length The number of elements in the array.
- */
-void printArray(int *arr, int length) {
-    for (int i = 0; i < length; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Merges two subarrays of arr[].
@@ -89,7 +79,7 @@ void printArray(int *arr, int length) {
  * @param m The ending index of the first subarray.
  * @param r The ending index of the second subarray.
  */
-void merge(int arr[], int l, int m, int r) {
+static void merge(int arr[], int l, int m, int r) {
     // Calculate the sizes of the two subarrays
     int n1 = m - l + 1;
     int n2 = r - m;
@@ -143,7 +133,12 @@ void merge(int arr[], int l, int m, int r) {
  * @param l The starting index of the array.
  * @param r The ending index of the array.
  */
-void mergeSort(int arr[], int l, int r) {
+static void mergeSort(int arr[], int l, int r) {
+    // Small ranges go to the sorting network (SIMD when the CPU has it)
+    if (r - l + 1 <= sort_network_cutoff()) {
+        sort_network(arr + l, r - l + 1);
+        return;
+    }
     if (l < r) {
         // Find the middle point of the array
         int m = l + (r - l) / 2;
@@ -157,17 +152,29 @@ void mergeSort(int arr[], int l, int r) {
     }
 }
 
+/**
+ * @brief Sorts an array of n elements using merge sort.
+ * 
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void merge_sort_simple(int *arr, int n) {
+    mergeSort(arr, 0, n - 1);
+}
+
+#ifdef SORT_DEMO
 // Driver code
 int main() {
     int arr[] = {64, 34, 25, 12, 22, 11, 90};
     int n = sizeof(arr) / sizeof(arr[0]);
 
     printf("Given array is \n");
-    printArray(arr, n);
+    sort_print_array(arr, n);
 
-    mergeSort(arr, 0, n - 1);
+    merge_sort_simple(arr, n);
 
     printf("\nSorted array is \n");
-    printArray(arr, n);
+    sort_print_array(arr, n);
     return 0;
 }
+#endif /* SORT_DEMO */
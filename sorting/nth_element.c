@@ -0,0 +1,294 @@
+/**
+ * @file nth_element.c
+ * @brief Selection: nth_element() and partial_sort() with Floyd-Rivest sampling.
+ *
+ * @details
+ * Finding one order statistic (a median, a p99 latency) does not require sorting. Quickselect
+ * partitions like quick sort but only continues into the side that holds position k, which
+ * takes O(n) time on average. This implementation partitions with
+ * sort_three_way_partition() from quick_sort_three_way.c, so runs of equal values end the
+ * search as soon as k falls among them, and chooses its pivots in three ways:
+ * - **Floyd-Rivest sampling**: for ranges above NTH_ELEMENT_SAMPLE_MIN elements, the pivot is
+ *   selected recursively from a sample of about n^(2/3) elements around the position k would
+ *   have in it. The pivot then lands very close to position k, so the next range is a small
+ *   fraction of the current one and the total work approaches n + min(k, n - k) comparisons.
+ * - **Median of three** for smaller ranges.
+ * - **Median of medians**: after 2 * log2(n) partitions without finishing, pivots are chosen
+ *   as the median of the medians of groups of five, which guarantees O(n) time on any input.
+ *
+ * partial_sort() selects the k smallest elements this way and then sorts just those.
+ *
+ * @section Performance
+ * - nth_element(): O(n) average and worst case.
+ * - partial_sort(): O(n + k log k).
+ * - Space Complexity: O(log n) - due to the recursion.
+ *
+ * @reference
+ * - Robert W. Floyd and Ronald L. Rivest, "Algorithm 489: The algorithm SELECT - for finding
+ *   the ith smallest of n elements", 1975.
+ * - Manuel Blum, Robert W. Floyd, Vaughan Pratt, Ronald L. Rivest and Robert E. Tarjan,
+ *   "Time bounds for selection", 1973.
+ * - David R. Musser, "Introspective Sorting and Selection Algorithms", 1997.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Ranges of this size or smaller are finished with insertion sort. */
+#define NTH_ELEMENT_INSERTION 16
+/** Ranges larger than this take their pivot from a Floyd-Rivest sample. */
+#define NTH_ELEMENT_SAMPLE_MIN 600
+
+/**
+ * @brief Insertion sort of arr[low..high].
+ */
+static void insertion_range(int *arr, int low, int high) {
+    for (int i = low + 1; i <= high; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= low && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+static void select_range(int *arr, int low, int high, int k, int budget);
+
+/**
+ * @brief Returns the index of the median of arr[a], arr[b] and arr[c].
+ */
+static int median_of_three(const int *arr, int a, int b, int c) {
+    if (arr[a] < arr[b]) {
+        return arr[b] < arr[c] ? b : (arr[a] < arr[c] ? c : a);
+    }
+    return arr[a] < arr[c] ? a : (arr[b] < arr[c] ? c : b);
+}
+
+/**
+ * @brief Moves the median of the medians of groups of five to the front part of
+ *        arr[low..high] and returns its index.
+ */
+static int median_of_medians(int *arr, int low, int high) {
+    int groups = 0;
+
+    for (int g = low; g <= high; g += 5) {
+        int end = g + 4 < high ? g + 4 : high;
+        insertion_range(arr, g, end);
+        sort_swap(&arr[low + groups], &arr[g + (end - g) / 2]);
+        groups++;
+    }
+
+    int mid = low + (groups - 1) / 2;
+    select_range(arr, low, low + groups - 1, mid, 0);
+    return mid;
+}
+
+/**
+ * @brief Places the element that belongs at position k of arr[low..high] there.
+ *
+ * @param budget Partitions left before the median of medians takes over; 0 uses it at once.
+ */
+static void select_range(int *arr, int low, int high, int k, int budget) {
+    while (high - low + 1 > NTH_ELEMENT_INSERTION) {
+        int p;
+        int n = high - low + 1;
+
+        if (budget == 0) {
+            p = median_of_medians(arr, low, high);
+        } else {
+            budget--;
+            if (n > NTH_ELEMENT_SAMPLE_MIN) {
+                // Select within a sample around k's expected place; its result lands at k
+                double z = log((double)n);
+                double s = 0.5 * exp(2.0 * z / 3.0);
+                double i = (double)(k - low + 1);
+                double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i < n / 2.0 ? -1.0 : 1.0);
+                int sample_low = (int)(k - i * s / n + sd);
+                int sample_high = (int)(k + (n - i) * s / n + sd);
+                if (sample_low < low)
+                    sample_low = low;
+                if (sample_high > high)
+                    sample_high = high;
+                if (sample_low > k)
+                    sample_low = k;
+                if (sample_high < k)
+                    sample_high = k;
+                select_range(arr, sample_low, sample_high, k, budget);
+                p = k;
+            } else {
+                p = median_of_three(arr, low, low + n / 2, high);
+            }
+        }
+
+        int lt, gt;
+        sort_swap(&arr[low], &arr[p]);
+        sort_three_way_partition(arr, low, high, &lt, &gt);
+        if (k < lt) {
+            high = lt - 1;
+        } else if (k > gt) {
+            low = gt + 1;
+        } else {
+            return;
+        }
+    }
+    insertion_range(arr, low, high);
+}
+
+/**
+ * @brief Number of partitions allowed before the median of medians takes over.
+ */
+static int select_budget(int n) {
+    int budget = 0;
+    for (int m = n; m > 1; m >>= 1)
+        budget += 2;
+    return budget;
+}
+
+/**
+ * @brief Rearranges an array so that arr[k] is the element that would be there if it were
+ *        sorted, with no larger element before it and no smaller one after it.
+ *
+ * @param arr The array.
+ * @param n The number of elements in the array.
+ * @param k The position to fill, 0 <= k < n.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int nth_element(int *arr, int n, int k) {
+    if (n < 0 || k < 0 || k >= n || arr == NULL) {
+        return -1;
+    }
+    select_range(arr, 0, n - 1, k, select_budget(n));
+    return 0;
+}
+
+/**
+ * @brief Puts the k smallest elements of an array, sorted, in arr[0..k); the order of the
+ *        rest is unspecified.
+ *
+ * @param arr The array.
+ * @param n The number of elements in the array.
+ * @param k The number of elements to sort, 0 <= k <= n.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int partial_sort(int *arr, int n, int k) {
+    if (n < 0 || k < 0 || k > n || (arr == NULL && n > 0)) {
+        return -1;
+    }
+    if (k < n) {
+        select_range(arr, 0, n - 1, k, select_budget(n));
+    }
+    intro_sort(arr, k);
+    return 0;
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Checks that arr[k] == sorted[k] and that arr is split around it.
+ */
+static void check_selected(const int *arr, const int *sorted, int n, int k) {
+    assert(arr[k] == sorted[k]);
+    for (int i = 0; i < k; i++) {
+        assert(arr[i] <= arr[k]);
+    }
+    for (int i = k + 1; i < n; i++) {
+        assert(arr[i] >= arr[k]);
+    }
+}
+
+/**
+ * @brief Driver code to demonstrate nth_element and partial_sort.
+ *
+ * Checks both against qsort() on many inputs, including the median-of-medians path on its
+ * own, and computes latency percentiles of a large buffer, timed against a full sort.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {7, 10, 4, 3, 20, 15};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    assert(nth_element(arr1, n1, 2) == 0);
+    assert(arr1[2] == 7);
+    assert(partial_sort(arr1, n1, 3) == 0);
+    sort_print_array(arr1, 3);
+    assert(arr1[0] == 3 && arr1[1] == 4 && arr1[2] == 7);
+    assert(nth_element(arr1, n1, n1) == -1);
+    assert(partial_sort(arr1, n1, n1 + 1) == -1);
+
+    enum { MAX_N = 3000 };
+    static int arr[MAX_N], sorted[MAX_N], copy[MAX_N];
+    srand(61);
+    for (int trial = 0; trial < 300; trial++) {
+        int n = 1 + rand() % MAX_N;
+        int range = trial % 3 == 0 ? 3 : (trial % 3 == 1 ? n : 1 << 30);
+        for (int i = 0; i < n; i++) {
+            arr[i] = trial % 7 == 0 ? i : rand() % range;  // Some sorted inputs
+        }
+        memcpy(sorted, arr, n * sizeof(int));
+        qsort(sorted, n, sizeof(int), compare_ints);
+        int k = rand() % n;
+
+        memcpy(copy, arr, n * sizeof(int));
+        assert(nth_element(copy, n, k) == 0);
+        check_selected(copy, sorted, n, k);
+
+        memcpy(copy, arr, n * sizeof(int));
+        select_range(copy, 0, n - 1, k, 0);  // Median of medians only
+        check_selected(copy, sorted, n, k);
+
+        memcpy(copy, arr, n * sizeof(int));
+        assert(partial_sort(copy, n, k) == 0);
+        assert(memcmp(copy, sorted, k * sizeof(int)) == 0);
+    }
+
+    // p50 and p99 of a large buffer of latencies, with a long tail
+    enum { N = 5000000 };
+    int *latency = malloc(N * sizeof(int));
+    int *work = malloc(N * sizeof(int));
+    assert(latency != NULL && work != NULL);
+    for (int i = 0; i < N; i++) {
+        latency[i] = 100 + rand() % 900 + (rand() % 100 == 0 ? rand() % 100000 : 0);
+    }
+    memcpy(work, latency, N * sizeof(int));
+    clock_t start = clock();
+    int p50_index = N / 2, p99_index = (int)(N * 0.99);
+    assert(nth_element(work, N, p99_index) == 0);
+    int p99 = work[p99_index];
+    assert(nth_element(work, p99_index, p50_index) == 0);  // The p50 is left of the p99
+    int p50 = work[p50_index];
+    double t_select = seconds_since(start);
+
+    memcpy(work, latency, N * sizeof(int));
+    start = clock();
+    qsort(work, N, sizeof(int), compare_ints);
+    double t_sort = seconds_since(start);
+    assert(work[p50_index] == p50 && work[p99_index] == p99);
+    printf("%d latencies: p50 %d, p99 %d; nth_element %.3fs, full sort %.3fs\n", N, p50, p99,
+           t_select, t_sort);
+    free(latency);
+    free(work);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
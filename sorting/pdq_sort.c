@@ -0,0 +1,392 @@
+/**
+ * @file pdq_sort.c
+ * @brief Implementation of Pattern-Defeating Quick Sort (pdqsort).
+ *
+ * @details
+ * quick_sort_simple.c always picks arr[high] as its pivot and quick_sort_dual_pivot.c always
+ * picks the two endpoints, so sorted, reverse-sorted and adversarial inputs make them go
+ * quadratic. Pattern-defeating quick sort keeps quick sort's speed on random data while
+ * removing those cases:
+ * - **Adaptive pivot selection**: median of three for small segments, Tukey's ninther
+ *   (median of three medians of three) above PDQ_NINTHER_THRESHOLD elements.
+ * - **Branchless block partitioning**: the comparisons of a block of SORT_BLOCK_SIZE elements
+ *   are turned into an offset buffer without any data-dependent branches, then the
+ *   misplaced elements are swapped in bulk (Edelkamp & Weiss, BlockQuicksort). The loop is
+ *   sort_block_partition() in sort_internal.h, which quick_sort_engine.c also uses.
+ * - **Already-partitioned detection**: if partitioning did not move anything, both sides get
+ *   a bounded insertion sort that gives up after PDQ_PARTIAL_INSERTION_SORT_LIMIT moves, so
+ *   sorted and nearly sorted runs finish in linear time.
+ * - **Pattern breaking**: after a highly unbalanced partition (one side smaller than 1/8) a few
+ *   elements are swapped to fixed positions, which breaks up the patterns that caused it.
+ * - **Equal elements**: when the pivot equals the element just left of the segment, all keys
+ *   equal to it are gathered on the left and skipped, so many duplicates cost O(n).
+ * - **Worst-case guarantee**: after log2(n) bad partitions the segment is handed to
+ *   heap_sort_bottom_up(), which caps the running time at O(n log n).
+ *
+ * @section Performance
+ * - Best Case Time Complexity: O(n) - sorted, reverse-sorted or all-equal input.
+ * - Average Case Time Complexity: O(n log n)
+ * - Worst Case Time Complexity: O(n log n)
+ * - Space Complexity: O(log n) - recursion stack plus two 64-byte offset buffers.
+ *
+ * @reference
+ * - Orson Peters, "Pattern-defeating Quicksort", arXiv:2106.05123, 2021.
+ * - Stefan Edelkamp and Armin Weiss, "BlockQuicksort: How Branch Mispredictions don't affect
+ *   Quicksort", ESA 2016.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Segments smaller than this are sorted with insertion sort. */
+#define PDQ_INSERTION_SORT_THRESHOLD 24
+/** Segments larger than this use the ninther instead of the median of three. */
+#define PDQ_NINTHER_THRESHOLD 128
+/** Number of element moves after which partial_insertion_sort() gives up. */
+#define PDQ_PARTIAL_INSERTION_SORT_LIMIT 8
+
+/**
+ * @brief Insertion sort of [begin, end).
+ *
+ * @param begin Pointer to the first element.
+ * @param end Pointer one past the last element.
+ */
+static void insertion_sort_range(int *begin, int *end) {
+    if (begin == end)
+        return;
+
+    for (int *cur = begin + 1; cur != end; cur++) {
+        int key = *cur;
+        int *sift = cur;
+        while (sift != begin && key < sift[-1]) {
+            *sift = sift[-1];
+            sift--;
+        }
+        *sift = key;
+    }
+}
+
+/**
+ * @brief Insertion sort of [begin, end) that relies on begin[-1] being a sentinel.
+ *
+ * Only valid when the element just before begin is no larger than any element in the range,
+ * which holds for every segment that is not the leftmost one.
+ *
+ * @param begin Pointer to the first element.
+ * @param end Pointer one past the last element.
+ */
+static void unguarded_insertion_sort(int *begin, int *end) {
+    if (begin == end)
+        return;
+
+    for (int *cur = begin + 1; cur != end; cur++) {
+        int key = *cur;
+        int *sift = cur;
+        while (key < sift[-1]) {
+            *sift = sift[-1];
+            sift--;
+        }
+        *sift = key;
+    }
+}
+
+/**
+ * @brief Insertion sort of [begin, end) that gives up once it has moved too many elements.
+ *
+ * @param begin Pointer to the first element.
+ * @param end Pointer one past the last element.
+ * @return 1 if the range is now sorted, 0 if the attempt was abandoned.
+ */
+static int partial_insertion_sort(int *begin, int *end) {
+    if (begin == end)
+        return 1;
+
+    int limit = 0;
+    for (int *cur = begin + 1; cur != end; cur++) {
+        int key = *cur;
+        int *sift = cur;
+        while (sift != begin && key < sift[-1]) {
+            *sift = sift[-1];
+            sift--;
+        }
+        *sift = key;
+        limit += (int)(cur - sift);
+
+        if (limit > PDQ_PARTIAL_INSERTION_SORT_LIMIT)
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Orders two elements.
+ */
+static void sort2(int *a, int *b) {
+    if (*b < *a)
+        sort_swap(a, b);
+}
+
+/**
+ * @brief Orders three elements so that *a <= *b <= *c.
+ */
+static void sort3(int *a, int *b, int *c) {
+    sort2(a, b);
+    sort2(b, c);
+    sort2(a, b);
+}
+
+/**
+ * @brief Partitions [begin, end) around *begin, placing keys equal to the pivot on the left.
+ *
+ * Used when the pivot equals the element before the segment: everything equal to it is
+ * already in its final position, so the caller can continue right of the returned pivot.
+ *
+ * @param begin Pointer to the first element (the pivot).
+ * @param end Pointer one past the last element.
+ * @return Pointer to the final position of the pivot.
+ */
+static int *partition_left(int *begin, int *end) {
+    int pivot = *begin;
+    int *first = begin;
+    int *last = end;
+
+    while (pivot < *--last)
+        ;
+    if (last + 1 == end)
+        while (first < last && !(pivot < *++first))
+            ;
+    else
+        while (!(pivot < *++first))
+            ;
+
+    while (first < last) {
+        sort_swap(first, last);
+        while (pivot < *--last)
+            ;
+        while (!(pivot < *++first))
+            ;
+    }
+
+    *begin = *last;
+    *last = pivot;
+    return last;
+}
+
+/**
+ * @brief Branchless partition of [begin, end) around *begin.
+ *
+ * Elements equal to the pivot go to the right. The pivot selection guarantees that an
+ * element >= pivot exists to the right of begin, which lets the first scan run unguarded.
+ *
+ * @param begin Pointer to the first element (the pivot).
+ * @param end Pointer one past the last element.
+ * @param already_partitioned Set to 1 if no element had to be moved.
+ * @return Pointer to the final position of the pivot.
+ */
+static int *partition_right_branchless(int *begin, int *end, int *already_partitioned) {
+    int pivot = *begin;
+    int *first = begin;
+    int *last = end;
+
+    // Find the first element >= pivot and the last element < pivot
+    while (*++first < pivot)
+        ;
+    if (first - 1 == begin)
+        while (first < last && !(*--last < pivot))
+            ;
+    else
+        while (!(*--last < pivot))
+            ;
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        sort_swap(first, last);
+        first = sort_block_partition(first + 1, last, pivot);
+    }
+
+    // Put the pivot in its final place
+    int *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/**
+ * @brief Main loop of pdqsort over [begin, end).
+ *
+ * @param begin Pointer to the first element.
+ * @param end Pointer one past the last element.
+ * @param bad_allowed Number of highly unbalanced partitions tolerated before heap sort.
+ * @param leftmost Nonzero if there is no element before begin that can serve as sentinel.
+ */
+static void pdq_sort_loop(int *begin, int *end, int bad_allowed, int leftmost) {
+    for (;;) {
+        int size = (int)(end - begin);
+
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            if (leftmost)
+                insertion_sort_range(begin, end);
+            else
+                unguarded_insertion_sort(begin, end);
+            return;
+        }
+
+        // Choose the pivot and move it to *begin
+        int s2 = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(begin, begin + s2, end - 1);
+            sort3(begin + 1, begin + (s2 - 1), end - 2);
+            sort3(begin + 2, begin + (s2 + 1), end - 3);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            sort_swap(begin, begin + s2);
+        } else {
+            sort3(begin + s2, begin, end - 1);
+        }
+
+        // If the pivot equals the element before this segment, every key equal to it is
+        // already in place: gather them on the left and continue with the rest
+        if (!leftmost && !(begin[-1] < *begin)) {
+            begin = partition_left(begin, end) + 1;
+            continue;
+        }
+
+        int already_partitioned;
+        int *pivot_pos = partition_right_branchless(begin, end, &already_partitioned);
+
+        int l_size = (int)(pivot_pos - begin);
+        int r_size = (int)(end - (pivot_pos + 1));
+        int highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            // Too many bad partitions: guarantee O(n log n) with heap sort
+            if (--bad_allowed == 0) {
+                heap_sort_bottom_up(begin, size);
+                return;
+            }
+
+            // Break up patterns by swapping a few elements to fixed positions
+            if (l_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                sort_swap(begin, begin + l_size / 4);
+                sort_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > PDQ_NINTHER_THRESHOLD) {
+                    sort_swap(begin + 1, begin + (l_size / 4 + 1));
+                    sort_swap(begin + 2, begin + (l_size / 4 + 2));
+                    sort_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    sort_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                sort_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                sort_swap(end - 1, end - r_size / 4);
+                if (r_size > PDQ_NINTHER_THRESHOLD) {
+                    sort_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    sort_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    sort_swap(end - 2, end - (1 + r_size / 4));
+                    sort_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned && partial_insertion_sort(begin, pivot_pos)
+                                       && partial_insertion_sort(pivot_pos + 1, end)) {
+            // The segment was (nearly) sorted already
+            return;
+        }
+
+        // Sort the left side recursively and the right side in this loop
+        pdq_sort_loop(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+/**
+ * @brief Sorts an array of n elements using pattern-defeating quick sort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void pdq_sort(int *arr, int n) {
+    // Allow log2(n) bad partitions before falling back to heap sort
+    int bad_allowed = 0;
+    for (int m = n; m > 0; m >>= 1) {
+        bad_allowed++;
+    }
+    pdq_sort_loop(arr, arr + n, bad_allowed, 1);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Checks that an array is sorted in non-decreasing order.
+ *
+ * @param arr The array to check.
+ * @param n The size of the array.
+ */
+static void assert_sorted(const int *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        assert(arr[i - 1] <= arr[i]);
+    }
+}
+
+/**
+ * @brief Driver code to demonstrate the pdq_sort function.
+ *
+ * Sorts a small fixed input against its expected result, then larger inputs with the
+ * patterns that make a fixed-pivot quick sort quadratic.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {5, 2, 8, 12, 3, -7, 0, 5};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    pdq_sort(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-7, 0, 2, 3, 5, 5, 8, 12};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    enum { N = 100000 };
+    static int big[N];
+
+    for (int i = 0; i < N; i++) big[i] = i;                 // Already sorted
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = N - i;             // Reverse sorted
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i % 16;            // Few distinct keys
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i < N / 2 ? i : N - i; // Organ pipe
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i;                 // Sorted with a few swaps
+    for (int i = 0; i < 10; i++) sort_swap(&big[(i * 7919) % N], &big[(i * 104729) % N]);
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+
+    srand(3);
+    long long sum_before = 0, sum_after = 0;
+    for (int i = 0; i < N; i++) {                           // Random, with negatives
+        big[i] = rand() - RAND_MAX / 2;
+        sum_before += big[i];
+    }
+    pdq_sort(big, N);
+    assert_sorted(big, N);
+    for (int i = 0; i < N; i++) sum_after += big[i];
+    assert(sum_before == sum_after);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,445 @@
+/**
+ * @file priority_queue.c
+ * @brief Implementation of a generic d-ary heap priority queue.
+ *
+ * @details
+ * The queue is the heap from heap_sort_bottom_up.c turned into a reusable data structure:
+ * - **Storage**: one array of elem_size-byte slots, grown by doubling, with one slot past the
+ *   capacity used as scratch space for the element being sifted. Sifts move a hole rather than
+ *   swapping, so each level costs one copy instead of three.
+ * - **Removal** (pop, remove, replace with a later element) uses Floyd's bottom-up sift: the
+ *   hole descends to a leaf comparing only children with each other, then the element rises
+ *   from there. The last element of the array, which refills the hole, nearly always belongs
+ *   near the bottom, so this saves about half the comparisons.
+ * - **Insertion** and pq_decrease_key() sift up, which costs O(log_d n).
+ * - **Heapify** builds the heap bottom-up in O(n); pq_push_bulk() does the same when the batch
+ *   is at least as large as the queue, and sifts each element up otherwise.
+ *
+ * @section Performance
+ * - push, decrease_key: O(log_d n) comparisons.
+ * - pop, remove, replace: O(d log_d n) comparisons.
+ * - heapify: O(n).
+ * - Space Complexity: O(n) - the elements themselves, plus one scratch slot.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "priority_queue.h"
+
+/** Children per node when pq_create() is passed 0. */
+#define PQ_DEFAULT_ARITY 4
+/** Capacity of the first allocation. */
+#define PQ_MIN_CAPACITY 16
+
+struct pq {
+    char *data;       /**< capacity + 1 slots; the last one is scratch. */
+    size_t size;
+    size_t capacity;
+    size_t elem_size;
+    size_t arity;
+    pq_compare_t compare;
+    pq_moved_t moved;
+};
+
+static inline char *slot(const pq_t *pq, size_t i) {
+    return pq->data + i * pq->elem_size;
+}
+
+static inline char *scratch(const pq_t *pq) {
+    return slot(pq, pq->capacity);
+}
+
+/**
+ * @brief Copies src into slot i and reports the move.
+ */
+static inline void store(pq_t *pq, size_t i, const void *src) {
+    memcpy(slot(pq, i), src, pq->elem_size);
+    if (pq->moved != NULL) {
+        pq->moved(slot(pq, i), i);
+    }
+}
+
+/**
+ * @brief Moves the scratch element from the hole at i up towards the root, but not above top.
+ */
+static void sift_up(pq_t *pq, size_t i, size_t top) {
+    const char *x = scratch(pq);
+
+    while (i > top) {
+        size_t parent = (i - 1) / pq->arity;
+        if (pq->compare(x, slot(pq, parent)) >= 0)
+            break;
+        store(pq, i, slot(pq, parent));
+        i = parent;
+    }
+    store(pq, i, x);
+}
+
+/**
+ * @brief Places the scratch element in the subtree whose root i is a hole, bottom-up.
+ */
+static void sift_down(pq_t *pq, size_t i) {
+    size_t hole = i;
+
+    for (;;) {
+        size_t first = pq->arity * hole + 1;
+        if (first >= pq->size)
+            break;
+        size_t last = first + pq->arity < pq->size ? first + pq->arity : pq->size;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (pq->compare(slot(pq, c), slot(pq, best)) < 0)
+                best = c;
+        }
+        store(pq, hole, slot(pq, best));
+        hole = best;
+    }
+    sift_up(pq, hole, i);
+}
+
+/**
+ * @brief Places the scratch element at the hole i, in whichever direction it belongs.
+ */
+static void sift(pq_t *pq, size_t i) {
+    if (i > 0 && pq->compare(scratch(pq), slot(pq, (i - 1) / pq->arity)) < 0) {
+        sift_up(pq, i, 0);
+    } else {
+        sift_down(pq, i);
+    }
+}
+
+/**
+ * @brief Restores the heap property over all elements, then reports every index.
+ */
+static void build(pq_t *pq) {
+    if (pq->size > 1) {
+        // The moves during the build are not reported; every final position is, below
+        pq_moved_t moved = pq->moved;
+        pq->moved = NULL;
+        for (size_t i = (pq->size - 2) / pq->arity + 1; i-- > 0;) {
+            memcpy(scratch(pq), slot(pq, i), pq->elem_size);
+            sift_down(pq, i);
+        }
+        pq->moved = moved;
+    }
+    if (pq->moved != NULL) {
+        for (size_t i = 0; i < pq->size; i++) {
+            pq->moved(slot(pq, i), i);
+        }
+    }
+}
+
+pq_t *pq_create(size_t elem_size, pq_compare_t compare, int arity) {
+    if (arity == 0) {
+        arity = PQ_DEFAULT_ARITY;
+    }
+    if (elem_size == 0 || compare == NULL || arity < 2 || arity > PQ_MAX_ARITY) {
+        return NULL;
+    }
+
+    pq_t *pq = calloc(1, sizeof(*pq));
+    if (pq == NULL) {
+        return NULL;
+    }
+    pq->elem_size = elem_size;
+    pq->arity = (size_t)arity;
+    pq->compare = compare;
+    pq->data = malloc((PQ_MIN_CAPACITY + 1) * elem_size);
+    if (pq->data == NULL) {
+        free(pq);
+        return NULL;
+    }
+    pq->capacity = PQ_MIN_CAPACITY;
+    return pq;
+}
+
+void pq_destroy(pq_t *pq) {
+    if (pq != NULL) {
+        free(pq->data);
+        free(pq);
+    }
+}
+
+void pq_set_moved(pq_t *pq, pq_moved_t moved) {
+    pq->moved = moved;
+}
+
+size_t pq_size(const pq_t *pq) {
+    return pq->size;
+}
+
+int pq_reserve(pq_t *pq, size_t capacity) {
+    if (capacity <= pq->capacity) {
+        return 0;
+    }
+    size_t grown = pq->capacity * 2 > capacity ? pq->capacity * 2 : capacity;
+    if (grown + 1 > (size_t)-1 / pq->elem_size) {
+        return -1;
+    }
+    char *data = realloc(pq->data, (grown + 1) * pq->elem_size);
+    if (data == NULL) {
+        return -1;
+    }
+    pq->data = data;
+    pq->capacity = grown;
+    return 0;
+}
+
+int pq_push(pq_t *pq, const void *element) {
+    if (pq_reserve(pq, pq->size + 1) != 0) {
+        return -1;
+    }
+    memcpy(scratch(pq), element, pq->elem_size);
+    sift_up(pq, pq->size++, 0);
+    return 0;
+}
+
+int pq_push_bulk(pq_t *pq, const void *elements, size_t count) {
+    if (count > (size_t)-1 - pq->size || pq_reserve(pq, pq->size + count) != 0) {
+        return -1;
+    }
+    if (count >= pq->size) {
+        memcpy(slot(pq, pq->size), elements, count * pq->elem_size);
+        pq->size += count;
+        build(pq);
+        return 0;
+    }
+    for (size_t k = 0; k < count; k++) {
+        memcpy(scratch(pq), (const char *)elements + k * pq->elem_size, pq->elem_size);
+        sift_up(pq, pq->size++, 0);
+    }
+    return 0;
+}
+
+int pq_heapify(pq_t *pq, const void *elements, size_t count) {
+    if (pq_reserve(pq, count) != 0) {
+        return -1;
+    }
+    if (count > 0) {
+        memmove(pq->data, elements, count * pq->elem_size);
+    }
+    pq->size = count;
+    build(pq);
+    return 0;
+}
+
+const void *pq_top(const pq_t *pq) {
+    return pq->size > 0 ? pq->data : NULL;
+}
+
+int pq_pop(pq_t *pq, void *out) {
+    return pq_remove(pq, 0, out);
+}
+
+int pq_decrease_key(pq_t *pq, size_t index, const void *element) {
+    if (index >= pq->size || pq->compare(element, slot(pq, index)) > 0) {
+        return -1;
+    }
+    memcpy(scratch(pq), element, pq->elem_size);
+    sift_up(pq, index, 0);
+    return 0;
+}
+
+int pq_replace(pq_t *pq, size_t index, const void *element) {
+    if (index >= pq->size) {
+        return -1;
+    }
+    memcpy(scratch(pq), element, pq->elem_size);
+    sift(pq, index);
+    return 0;
+}
+
+int pq_remove(pq_t *pq, size_t index, void *out) {
+    if (index >= pq->size) {
+        return -1;
+    }
+    if (out != NULL) {
+        memcpy(out, slot(pq, index), pq->elem_size);
+    }
+    // The last element fills the hole
+    pq->size--;
+    if (index < pq->size) {
+        memcpy(scratch(pq), slot(pq, pq->size), pq->elem_size);
+        sift(pq, index);
+    }
+    return 0;
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_ints_desc(const void *a, const void *b) {
+    return compare_ints(b, a);
+}
+
+/**
+ * @brief A task of a deadline scheduler; the queue holds pointers to tasks.
+ */
+typedef struct {
+    int deadline;
+    size_t heap_index;
+} task_t;
+
+static int compare_tasks(const void *a, const void *b) {
+    const task_t *x = *(task_t *const *)a, *y = *(task_t *const *)b;
+    return (x->deadline > y->deadline) - (x->deadline < y->deadline);
+}
+
+static void task_moved(const void *element, size_t index) {
+    (*(task_t *const *)element)->heap_index = index;
+}
+
+/**
+ * @brief Checks the heap property and that every task knows its index.
+ */
+static void check_tasks(const pq_t *pq) {
+    for (size_t i = 0; i < pq_size(pq); i++) {
+        task_t *t = *(task_t *const *)slot(pq, i);
+        assert(t->heap_index == i);
+        if (i > 0) {
+            assert(compare_tasks(slot(pq, (i - 1) / pq->arity), slot(pq, i)) <= 0);
+        }
+    }
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Driver code to demonstrate the priority queue.
+ *
+ * Drains queues of every arity against qsort(), runs a small deadline scheduler that
+ * reschedules and cancels tasks through their tracked indices, and times a million
+ * push/pop pairs for each arity.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int values[] = {5, 2, 8, 12, 3, 2, -7};
+    int n = sizeof(values) / sizeof(values[0]);
+    pq_t *pq = pq_create(sizeof(int), compare_ints_desc, 0);
+    assert(pq != NULL && pq_top(pq) == NULL);
+    assert(pq_pop(pq, NULL) == -1);
+    for (int i = 0; i < n; i++) {
+        assert(pq_push(pq, &values[i]) == 0);
+    }
+    int drained[7];
+    for (int i = 0; i < n; i++) {
+        assert(pq_pop(pq, &drained[i]) == 0);
+    }
+    sort_print_array(drained, n);
+    int expected[] = {12, 8, 5, 3, 2, 2, -7};
+    for (int i = 0; i < n; i++) {
+        assert(drained[i] == expected[i]);
+    }
+    pq_destroy(pq);
+    assert(pq_create(sizeof(int), compare_ints, 1) == NULL);
+    assert(pq_create(sizeof(int), compare_ints, PQ_MAX_ARITY + 1) == NULL);
+
+    // Every arity, filled by heapify, bulk push and single pushes, must drain in order
+    enum { M = 5000 };
+    static int input[M], ref[M];
+    srand(53);
+    for (int arity = 2; arity <= PQ_MAX_ARITY; arity++) {
+        for (int i = 0; i < M; i++) {
+            input[i] = rand() % (arity % 2 ? 50 : 100000);
+        }
+        memcpy(ref, input, sizeof(input));
+        qsort(ref, M, sizeof(int), compare_ints);
+
+        pq = pq_create(sizeof(int), compare_ints, arity);
+        assert(pq != NULL);
+        assert(pq_heapify(pq, input, M / 2) == 0);
+        assert(pq_push_bulk(pq, input + M / 2, M / 4) == 0);       // Small batch: sifted up
+        assert(pq_push_bulk(pq, input + M / 2 + M / 4, 10) == 0);
+        for (int i = M / 2 + M / 4 + 10; i < M; i++) {
+            assert(pq_push(pq, &input[i]) == 0);
+        }
+        assert(pq_size(pq) == M);
+        for (int i = 0; i < M; i++) {
+            int x;
+            assert(*(const int *)pq_top(pq) == ref[i]);
+            assert(pq_pop(pq, &x) == 0 && x == ref[i]);
+        }
+        assert(pq_push_bulk(pq, input, M) == 0);                   // Large batch: rebuilt
+        for (int i = 0; i < M; i++) {
+            int x;
+            assert(pq_pop(pq, &x) == 0 && x == ref[i]);
+        }
+        pq_destroy(pq);
+    }
+
+    // Deadline scheduler: tasks are rescheduled and cancelled through their tracked index
+    enum { TASKS = 1000 };
+    static task_t tasks[TASKS];
+    static int cancelled[TASKS];
+    pq = pq_create(sizeof(task_t *), compare_tasks, 4);
+    assert(pq != NULL);
+    pq_set_moved(pq, task_moved);
+    for (int i = 0; i < TASKS; i++) {
+        tasks[i].deadline = rand() % 100000;
+        task_t *t = &tasks[i];
+        assert(pq_push(pq, &t) == 0);
+    }
+    check_tasks(pq);
+    for (int i = 0; i < TASKS; i += 3) {
+        task_t *t = &tasks[i];
+        size_t index = t->heap_index;
+        tasks[i].deadline -= 500;                                   // Changed in place...
+        assert(pq_decrease_key(pq, index, &t) == 0);               // ...then re-sifted
+    }
+    for (int i = 1; i < TASKS; i += 7) {
+        task_t *t = &tasks[i];
+        tasks[i].deadline += 700;
+        assert(pq_replace(pq, t->heap_index, &t) == 0);
+    }
+    for (int i = 2; i < TASKS; i += 5) {
+        task_t *out;
+        assert(pq_remove(pq, tasks[i].heap_index, &out) == 0 && out == &tasks[i]);
+        cancelled[i] = 1;
+    }
+    check_tasks(pq);
+    int last = -1000000, remaining = 0;
+    task_t *t;
+    while (pq_pop(pq, &t) == 0) {
+        assert(!cancelled[t - tasks] && t->deadline >= last);
+        last = t->deadline;
+        remaining++;
+    }
+    assert(remaining == TASKS - (TASKS - 2 + 4) / 5);
+    pq_destroy(pq);
+
+    enum { OPS = 1000000 };
+    for (int arity = 2; arity <= PQ_MAX_ARITY; arity *= 2) {
+        pq = pq_create(sizeof(int), compare_ints, arity);
+        assert(pq != NULL);
+        clock_t start = clock();
+        for (int i = 0; i < OPS; i++) {
+            int x = rand();
+            pq_push(pq, &x);
+        }
+        int prev = -1, x;
+        while (pq_pop(pq, &x) == 0) {
+            assert(x >= prev);
+            prev = x;
+        }
+        printf("%d-ary: %d pushes and pops in %.3fs\n", arity, OPS, seconds_since(start));
+        pq_destroy(pq);
+    }
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,138 @@
+/**
+ * @file priority_queue.h
+ * @brief Priority queue over elements of any type, stored in a d-ary heap.
+ *
+ * @details
+ * The queue copies elements of a fixed size into one growable array and orders them with a
+ * qsort()-style comparator: pq_top() is the element that compares smallest, so reversing the
+ * comparator gives a max-queue. Every node has 2 to 8 children (4 by default); wider nodes
+ * make the heap shallower and keep the children of a node in the same cache line or two.
+ *
+ * Elements can be changed or removed at any position, given their current index. Since the
+ * heap moves elements around, a callback set with pq_set_moved() is told the new index of every
+ * element that is stored; a scheduler that queues pointers to its tasks uses it to keep each
+ * task's index up to date for pq_decrease_key() and pq_remove().
+ *
+ * @section Example Usage
+ * @code
+ * pq_t *pq = pq_create(sizeof(int), compare_ints, 0);
+ * pq_push(pq, &(int){5});
+ * pq_push(pq, &(int){2});
+ * int x;
+ * pq_pop(pq, &x); // x == 2
+ * pq_destroy(pq);
+ * @endcode
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <stddef.h>
+
+/** Largest number of children per node. */
+#define PQ_MAX_ARITY 8
+
+typedef struct pq pq_t;
+
+/** Returns a negative value, zero or a positive value if a orders before, with or after b. */
+typedef int (*pq_compare_t)(const void *a, const void *b);
+
+/** Told that element (the copy inside the queue) is now stored at index. */
+typedef void (*pq_moved_t)(const void *element, size_t index);
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param elem_size Size of each element in bytes.
+ * @param compare Ordering of the elements; pq_top() is the smallest.
+ * @param arity Children per node, 2 to PQ_MAX_ARITY, or 0 for the default of 4.
+ * @return The new queue, or NULL if the arguments are invalid or memory cannot be allocated.
+ */
+pq_t *pq_create(size_t elem_size, pq_compare_t compare, int arity);
+
+/**
+ * @brief Frees a queue and the elements it holds.
+ *
+ * @param pq The queue, may be NULL.
+ */
+void pq_destroy(pq_t *pq);
+
+/**
+ * @brief Sets (or with NULL clears) the callback told about every element that is stored.
+ */
+void pq_set_moved(pq_t *pq, pq_moved_t moved);
+
+/**
+ * @brief Returns the number of elements in the queue.
+ */
+size_t pq_size(const pq_t *pq);
+
+/**
+ * @brief Makes room for at least capacity elements.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated.
+ */
+int pq_reserve(pq_t *pq, size_t capacity);
+
+/**
+ * @brief Adds a copy of element, which must not point into the queue itself.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated.
+ */
+int pq_push(pq_t *pq, const void *element);
+
+/**
+ * @brief Adds copies of count consecutive elements.
+ *
+ * Large batches are appended and the heap is rebuilt in linear time instead of sifting each
+ * element up.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated (the queue is then unchanged).
+ */
+int pq_push_bulk(pq_t *pq, const void *elements, size_t count);
+
+/**
+ * @brief Replaces the contents of the queue with count elements, in linear time.
+ *
+ * @return 0 on success, -1 if memory cannot be allocated (the queue is then unchanged).
+ */
+int pq_heapify(pq_t *pq, const void *elements, size_t count);
+
+/**
+ * @brief Returns the smallest element, or NULL if the queue is empty.
+ *
+ * The pointer is valid until the queue is next modified.
+ */
+const void *pq_top(const pq_t *pq);
+
+/**
+ * @brief Removes the smallest element.
+ *
+ * @param out Receives the element; may be NULL.
+ * @return 0 on success, -1 if the queue is empty.
+ */
+int pq_pop(pq_t *pq, void *out);
+
+/**
+ * @brief Replaces the element at index with one that orders no later.
+ *
+ * @return 0 on success, -1 if index is out of range or element orders after the current one.
+ */
+int pq_decrease_key(pq_t *pq, size_t index, const void *element);
+
+/**
+ * @brief Replaces the element at index with any element.
+ *
+ * @return 0 on success, -1 if index is out of range.
+ */
+int pq_replace(pq_t *pq, size_t index, const void *element);
+
+/**
+ * @brief Removes the element at index.
+ *
+ * @param out Receives the element; may be NULL.
+ * @return 0 on success, -1 if index is out of range.
+ */
+int pq_remove(pq_t *pq, size_t index, void *out);
+
+#endif /* PRIORITY_QUEUE_H */
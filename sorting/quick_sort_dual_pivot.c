@@ -18,34 +18,8 @@
 
 #include <stdio.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param len The number of elements in the array.
- */
-void printf_array(int *arr, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
-
-/**
- * @brief Swaps two elements in an array.
- * 
- * This function swaps the values of two elements in the array.
- * 
- * @param a Pointer to the first element.
- * @param b Pointer to the second element.
- */
-void swap(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
+#include "sort.h"
+#include "sort_internal.h"
 
 /**
  * @brief Partitions the array for dual-pivot quick sort.
@@ -59,9 +33,9 @@ void swap(int *a, int *b) {
  * @param lp Pointer to the index of the first pivot after partitioning.
  * @param rp Pointer to the index of the second pivot after partitioning.
  */
-void dual_pivot_partition(int *arr, int low, int high, int *lp, int *rp) {
+static void dual_pivot_partition(int *arr, int low, int high, int *lp, int *rp) {
     if (arr[low] > arr[high]) {
-        swap(&arr[low], &arr[high]);
+        sort_swap(&arr[low], &arr[high]);
     }
     int pivot1 = arr[low];
     int pivot2 = arr[high];
@@ -71,10 +45,10 @@ void dual_pivot_partition(int *arr, int low, int high, int *lp, int *rp) {
 
     while (i <= gt) {
         if (arr[i] < pivot1) {
-            swap(&arr[i], &arr[lt]);
+            sort_swap(&arr[i], &arr[lt]);
             lt++;
         } else if (arr[i] > pivot2) {
-            swap(&arr[i], &arr[gt]);
+            sort_swap(&arr[i], &arr[gt]);
             gt--;
             i--;
         }
@@ -82,8 +56,8 @@ void dual_pivot_partition(int *arr, int low, int high, int *lp, int *rp) {
     }
     lt--;
     gt++;
-    swap(&arr[low], &arr[lt]);
-    swap(&arr[high], &arr[gt]);
+    sort_swap(&arr[low], &arr[lt]);
+    sort_swap(&arr[high], &arr[gt]);
     *lp = lt;
     *rp = gt;
 }
@@ -98,7 +72,7 @@ void dual_pivot_partition(int *arr, int low, int high, int *lp, int *rp) {
  * @param low The starting index of the array segment to be sorted.
  * @param high The ending index of the array segment to be sorted.
  */
-void quick_sort(int *arr, int low, int high) {
+static void quick_sort(int *arr, int low, int high) {
     if (low < high) {
         int lp, rp;
         dual_pivot_partition(arr, low, high, &lp, &rp);
@@ -109,6 +83,17 @@ void quick_sort(int *arr, int low, int high) {
     }
 }
 
+/**
+ * @brief Sorts an array of n elements using dual-pivot quick sort.
+ * 
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void quick_sort_dual_pivot(int *arr, int n) {
+    quick_sort(arr, 0, n - 1);
+}
+
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the dual-pivot quick sort algorithm.
  * 
@@ -124,11 +109,10 @@ int main() {
     int n = sizeof(unsorted_array) / sizeof(unsorted_array[0]);
 
     // Sort the array using dual-pivot quick sort
-    quick_sort(unsorted_array, 0, n - 1);
+    quick_sort_dual_pivot(unsorted_array, n);
     // Print the sorted array
-    printf_array(unsorted_array, n);
+    sort_print_array(unsorted_array, n);
 
     return 0;
 }
-
-
+#endif /* SORT_DEMO */
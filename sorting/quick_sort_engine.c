@@ -0,0 +1,602 @@
+/**
+ * @file quick_sort_engine.c
+ * @brief Quick sort with a selectable partition kernel, including AVX2/AVX-512 partitioning.
+ *
+ * @details
+ * partition() in quick_sort_simple.c compares one element at a time, and on random data the
+ * branch on each comparison mispredicts about half the time. quick_sort_engine() is a quick
+ * sort whose partition step is a pluggable kernel, chosen by a quick_sort_mode_t:
+ * - **QUICK_SORT_SCALAR**: a two-pointer Hoare-style partition, one element at a time.
+ * - **QUICK_SORT_VECTORIZED**: compares a whole vector (16 lanes with AVX-512, 8 with AVX2)
+ *   against the pivot at once and writes the lanes that go left and the lanes that go right
+ *   to the two ends of the array without any branch on the data. AVX-512 does this with
+ *   compress-stores; AVX2 has no compress instruction, so the comparison mask indexes a table
+ *   of 256 permutations that pack the left lanes to the front of the vector, which is then
+ *   stored at both ends.
+ * - **QUICK_SORT_BRANCHLESS**: BlockQuicksort-style. A block of 64 elements from each end is
+ *   classified first, recording the offsets of misplaced elements with conditional index
+ *   arithmetic instead of branches; the recorded pairs are then swapped. The blocks shrink
+ *   to split the remainder, so no other pass is needed.
+ * - **QUICK_SORT_AUTO**: the vectorized kernel if the CPU supports one, scalar otherwise.
+ *
+ * The vectorized kernels follow Bramas and vqsort: the first and last vector of the segment
+ * are held in registers, which leaves room at both ends, and each further vector is read
+ * from whichever end has less room left, so the writes never overtake the reads.
+ *
+ * Around the kernel, the engine picks the pivot as a median of three (a ninther for large
+ * segments), moves the elements less than the pivot to the left, recurses into the smaller
+ * side and loops on the larger one. A segment where nothing is less than the pivot has its
+ * copies of the pivot moved to the front and skipped, so runs of duplicates are cheap. Past
+ * 2 * log2(n) levels the segment goes to heap_sort_bottom_up(), and segments of at most
+ * sort_network_cutoff() elements are finished with sort_network().
+ *
+ * @section Performance
+ * - Average Case Time Complexity: O(n log n), with the partition passes W lanes at a time.
+ * - Worst Case Time Complexity: O(n log n) - heap sort takes over on bad pivots.
+ * - Space Complexity: O(log n) - due to the recursion stack.
+ *
+ * Quick sort is not stable.
+ *
+ * @reference
+ * - Stefan Edelkamp, Armin Weiss, "BlockQuicksort: How Branch Mispredictions don't affect
+ *   Quicksort", 2016.
+ * - Berenger Bramas, "A Novel Hybrid Quicksort Algorithm Vectorized using AVX-512 on Intel
+ *   Skylake", 2017.
+ * - Mark Blacher, Joachim Giesen, Peter Sanders, Jan Wassenberg, "Vectorized and
+ *   performance-portable Quicksort", 2022.
+ *
+ * Author: Kiran Jojare
+ */
+
+#if defined(SORT_DEMO) && defined(__linux__)
+#define _DEFAULT_SOURCE // syscall(), for the branch-miss counter in the demo
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUICK_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(SORT_DEMO) && defined(__linux__)
+#define QUICK_SORT_PERF 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/** Segments of at least this size take their pivot as a ninther rather than a median of three. */
+#define QUICK_SORT_NINTHER_MIN 1024
+
+/**
+ * @brief A partition kernel: moves the elements of arr[0..n) that are less than bound to the
+ *        front and returns how many there are.
+ */
+typedef int (*partition_kernel_t)(int *arr, int n, int bound);
+
+/**
+ * @brief Scalar kernel: two indices move towards each other and swap misplaced pairs.
+ */
+static int partition_scalar(int *arr, int n, int bound) {
+    int i = 0, j = n - 1;
+
+    for (;;) {
+        while (i <= j && arr[i] < bound)
+            i++;
+        while (i <= j && arr[j] >= bound)
+            j--;
+        if (i >= j)
+            break;
+        sort_swap(&arr[i++], &arr[j--]);
+    }
+    return i;
+}
+
+/**
+ * @brief Branchless kernel: block partitioning as in BlockQuicksort, with the block loop
+ *        shared with pdq_sort() (sort_block_partition()).
+ */
+static int partition_branchless(int *arr, int n, int bound) {
+    return (int)(sort_block_partition(arr, arr + n, bound) - arr);
+}
+
+#ifdef QUICK_SORT_X86
+
+/*
+ * For each 8-bit mask of lanes that go left, the lane order that puts those lanes first and
+ * the others after them, one lane index per nibble (lane 0 in the low nibble).
+ */
+static const uint32_t avx2_partition_perm[256] = {
+    0x76543210, 0x76543210, 0x76543201, 0x76543210, 0x76543102, 0x76543120, 0x76543021, 0x76543210,
+    0x76542103, 0x76542130, 0x76542031, 0x76542310, 0x76541032, 0x76541320, 0x76540321, 0x76543210,
+    0x76532104, 0x76532140, 0x76532041, 0x76532410, 0x76531042, 0x76531420, 0x76530421, 0x76534210,
+    0x76521043, 0x76521430, 0x76520431, 0x76524310, 0x76510432, 0x76514320, 0x76504321, 0x76543210,
+    0x76432105, 0x76432150, 0x76432051, 0x76432510, 0x76431052, 0x76431520, 0x76430521, 0x76435210,
+    0x76421053, 0x76421530, 0x76420531, 0x76425310, 0x76410532, 0x76415320, 0x76405321, 0x76453210,
+    0x76321054, 0x76321540, 0x76320541, 0x76325410, 0x76310542, 0x76315420, 0x76305421, 0x76354210,
+    0x76210543, 0x76215430, 0x76205431, 0x76254310, 0x76105432, 0x76154320, 0x76054321, 0x76543210,
+    0x75432106, 0x75432160, 0x75432061, 0x75432610, 0x75431062, 0x75431620, 0x75430621, 0x75436210,
+    0x75421063, 0x75421630, 0x75420631, 0x75426310, 0x75410632, 0x75416320, 0x75406321, 0x75463210,
+    0x75321064, 0x75321640, 0x75320641, 0x75326410, 0x75310642, 0x75316420, 0x75306421, 0x75364210,
+    0x75210643, 0x75216430, 0x75206431, 0x75264310, 0x75106432, 0x75164320, 0x75064321, 0x75643210,
+    0x74321065, 0x74321650, 0x74320651, 0x74326510, 0x74310652, 0x74316520, 0x74306521, 0x74365210,
+    0x74210653, 0x74216530, 0x74206531, 0x74265310, 0x74106532, 0x74165320, 0x74065321, 0x74653210,
+    0x73210654, 0x73216540, 0x73206541, 0x73265410, 0x73106542, 0x73165420, 0x73065421, 0x73654210,
+    0x72106543, 0x72165430, 0x72065431, 0x72654310, 0x71065432, 0x71654320, 0x70654321, 0x76543210,
+    0x65432107, 0x65432170, 0x65432071, 0x65432710, 0x65431072, 0x65431720, 0x65430721, 0x65437210,
+    0x65421073, 0x65421730, 0x65420731, 0x65427310, 0x65410732, 0x65417320, 0x65407321, 0x65473210,
+    0x65321074, 0x65321740, 0x65320741, 0x65327410, 0x65310742, 0x65317420, 0x65307421, 0x65374210,
+    0x65210743, 0x65217430, 0x65207431, 0x65274310, 0x65107432, 0x65174320, 0x65074321, 0x65743210,
+    0x64321075, 0x64321750, 0x64320751, 0x64327510, 0x64310752, 0x64317520, 0x64307521, 0x64375210,
+    0x64210753, 0x64217530, 0x64207531, 0x64275310, 0x64107532, 0x64175320, 0x64075321, 0x64753210,
+    0x63210754, 0x63217540, 0x63207541, 0x63275410, 0x63107542, 0x63175420, 0x63075421, 0x63754210,
+    0x62107543, 0x62175430, 0x62075431, 0x62754310, 0x61075432, 0x61754320, 0x60754321, 0x67543210,
+    0x54321076, 0x54321760, 0x54320761, 0x54327610, 0x54310762, 0x54317620, 0x54307621, 0x54376210,
+    0x54210763, 0x54217630, 0x54207631, 0x54276310, 0x54107632, 0x54176320, 0x54076321, 0x54763210,
+    0x53210764, 0x53217640, 0x53207641, 0x53276410, 0x53107642, 0x53176420, 0x53076421, 0x53764210,
+    0x52107643, 0x52176430, 0x52076431, 0x52764310, 0x51076432, 0x51764320, 0x50764321, 0x57643210,
+    0x43210765, 0x43217650, 0x43207651, 0x43276510, 0x43107652, 0x43176520, 0x43076521, 0x43765210,
+    0x42107653, 0x42176530, 0x42076531, 0x42765310, 0x41076532, 0x41765320, 0x40765321, 0x47653210,
+    0x32107654, 0x32176540, 0x32076541, 0x32765410, 0x31076542, 0x31765420, 0x30765421, 0x37654210,
+    0x21076543, 0x21765430, 0x20765431, 0x27654310, 0x10765432, 0x17654320, 0x07654321, 0x76543210,
+};
+
+/**
+ * @brief Packs the lanes of v selected by mask to the front, keeping the others after them.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2_pack_left(__m256i v, int mask) {
+    const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    __m256i code = _mm256_set1_epi32((int)avx2_partition_perm[mask]);
+    __m256i index = _mm256_and_si256(_mm256_srlv_epi32(code, shifts), _mm256_set1_epi32(15));
+
+    return _mm256_permutevar8x32_epi32(v, index);
+}
+
+/**
+ * @brief AVX2 kernel: 8 lanes per step, written through the permutation table.
+ *
+ * The packed vector is stored whole at both write positions. Only its first cnt lanes (left)
+ * or last 8 - cnt lanes (right) land in the partitioned part; the rest fall into space that
+ * has already been read and is overwritten later.
+ */
+__attribute__((target("avx2")))
+static int partition_avx2(int *arr, int n, int bound) {
+    enum { W = 8 };
+
+    if (n < 2 * W) {
+        return partition_scalar(arr, n, bound);
+    }
+
+    const __m256i b = _mm256_set1_epi32(bound);
+    __m256i first = _mm256_loadu_si256((const __m256i *)arr);
+    __m256i last = _mm256_loadu_si256((const __m256i *)(arr + n - W));
+    int lw = 0, rw = n;     // arr[0..lw) is left of the pivot, arr[rw..n) right of it
+    int lr = W, rr = n - W; // arr[lr..rr) has not been read yet
+
+    while (rr - lr >= W) {
+        __m256i v;
+        if (lr - lw <= rw - rr) {
+            v = _mm256_loadu_si256((const __m256i *)(arr + lr));
+            lr += W;
+        } else {
+            rr -= W;
+            v = _mm256_loadu_si256((const __m256i *)(arr + rr));
+        }
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, v)));
+        int cnt = __builtin_popcount(mask);
+        __m256i packed = avx2_pack_left(v, mask);
+        _mm256_storeu_si256((__m256i *)(arr + lw), packed);
+        _mm256_storeu_si256((__m256i *)(arr + rw - W), packed);
+        lw += cnt;
+        rw -= W - cnt;
+    }
+
+    while (lr < rr) {
+        int x = lr - lw <= rw - rr ? arr[lr++] : arr[--rr];
+        if (x < bound)
+            arr[lw++] = x;
+        else
+            arr[--rw] = x;
+    }
+
+    // Exactly 2 * W free slots are left for the two vectors held back at the start
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, first)));
+    __m256i packed = avx2_pack_left(first, mask);
+    _mm256_storeu_si256((__m256i *)(arr + lw), packed);
+    _mm256_storeu_si256((__m256i *)(arr + rw - W), packed);
+    lw += __builtin_popcount(mask);
+
+    // ...and then exactly W, which the last packed vector fills as it is
+    mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, last)));
+    _mm256_storeu_si256((__m256i *)(arr + lw), avx2_pack_left(last, mask));
+    return lw + __builtin_popcount(mask);
+}
+
+/**
+ * @brief Writes the lanes of v that are less than b at arr + *lw and the others just below
+ *        arr + *rw, with two compress-stores.
+ */
+__attribute__((target("avx512f")))
+static inline void avx512_scatter(int *arr, __m512i v, __m512i b, int *lw, int *rw) {
+    __mmask16 mask = _mm512_cmplt_epi32_mask(v, b);
+    int cnt = __builtin_popcount(mask);
+
+    _mm512_mask_compressstoreu_epi32(arr + *lw, mask, v);
+    *lw += cnt;
+    *rw -= 16 - cnt;
+    _mm512_mask_compressstoreu_epi32(arr + *rw, (__mmask16)~mask, v);
+}
+
+/**
+ * @brief AVX-512 kernel: 16 lanes per step, written with compress-stores.
+ */
+__attribute__((target("avx512f")))
+static int partition_avx512(int *arr, int n, int bound) {
+    enum { W = 16 };
+
+    if (n < 2 * W) {
+        return partition_scalar(arr, n, bound);
+    }
+
+    const __m512i b = _mm512_set1_epi32(bound);
+    __m512i first = _mm512_loadu_si512(arr);
+    __m512i last = _mm512_loadu_si512(arr + n - W);
+    int lw = 0, rw = n;     // arr[0..lw) is left of the pivot, arr[rw..n) right of it
+    int lr = W, rr = n - W; // arr[lr..rr) has not been read yet
+
+    while (rr - lr >= W) {
+        __m512i v;
+        if (lr - lw <= rw - rr) {
+            v = _mm512_loadu_si512(arr + lr);
+            lr += W;
+        } else {
+            rr -= W;
+            v = _mm512_loadu_si512(arr + rr);
+        }
+        avx512_scatter(arr, v, b, &lw, &rw);
+    }
+
+    while (lr < rr) {
+        int x = lr - lw <= rw - rr ? arr[lr++] : arr[--rr];
+        if (x < bound)
+            arr[lw++] = x;
+        else
+            arr[--rw] = x;
+    }
+
+    avx512_scatter(arr, first, b, &lw, &rw);
+    avx512_scatter(arr, last, b, &lw, &rw);
+    return lw;
+}
+
+#endif /* QUICK_SORT_X86 */
+
+/**
+ * @brief Returns the kernel for a mode, or NULL if the mode is invalid.
+ */
+static partition_kernel_t select_kernel(quick_sort_mode_t mode) {
+    switch (mode) {
+    case QUICK_SORT_AUTO:
+    case QUICK_SORT_VECTORIZED:
+#ifdef QUICK_SORT_X86
+        switch (sort_simd_level()) {
+        case SORT_SIMD_AVX512:
+            return partition_avx512;
+        case SORT_SIMD_AVX2:
+            return partition_avx2;
+        }
+#endif
+        return partition_scalar;
+    case QUICK_SORT_SCALAR:
+        return partition_scalar;
+    case QUICK_SORT_BRANCHLESS:
+        return partition_branchless;
+    default:
+        return NULL;
+    }
+}
+
+static inline int median_of_three(int a, int b, int c) {
+    if (a > b) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    // Now a <= b; the median is b clamped to [a, c] when c is below b
+    return c < b ? (c > a ? c : a) : b;
+}
+
+/**
+ * @brief Chooses a pivot value from n > 3 elements.
+ */
+static int choose_pivot(const int *arr, int n) {
+    int q = n / 4;
+
+    if (n < QUICK_SORT_NINTHER_MIN) {
+        return median_of_three(arr[q], arr[n / 2], arr[n - 1 - q]);
+    }
+    int s = n / 8;
+    return median_of_three(median_of_three(arr[0], arr[s], arr[2 * s]),
+                           median_of_three(arr[n / 2 - s], arr[n / 2], arr[n / 2 + s]),
+                           median_of_three(arr[n - 1 - 2 * s], arr[n - 1 - s], arr[n - 1]));
+}
+
+/**
+ * @brief Sorts arr[0..n) with the given kernel and depth budget.
+ */
+static void engine_sort(int *arr, int n, partition_kernel_t partition, int cutoff, int depth) {
+    while (n > cutoff) {
+        if (depth-- == 0) {
+            heap_sort_bottom_up(arr, n);
+            return;
+        }
+        int pivot = choose_pivot(arr, n);
+        int m = partition(arr, n, pivot);
+
+        if (m == 0) {
+            // The pivot is the minimum: move its copies to the front and skip them
+            if (pivot == INT_MAX) {
+                return; // Every element is INT_MAX
+            }
+            m = partition(arr, n, pivot + 1);
+            arr += m;
+            n -= m;
+            continue;
+        }
+        if (m < n - m) {
+            engine_sort(arr, m, partition, cutoff, depth);
+            arr += m;
+            n -= m;
+        } else {
+            engine_sort(arr + m, n - m, partition, cutoff, depth);
+            n = m;
+        }
+    }
+    sort_network(arr, n);
+}
+
+/**
+ * @brief Sorts an array of n elements using quick sort with the chosen partition kernel.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param mode The partition kernel; QUICK_SORT_VECTORIZED falls back to the scalar kernel
+ *             on CPUs without AVX2.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int quick_sort_engine(int *arr, int n, quick_sort_mode_t mode) {
+    partition_kernel_t partition = select_kernel(mode);
+
+    if (partition == NULL || n < 0 || (arr == NULL && n > 0)) {
+        return -1;
+    }
+    int depth = 0;
+    for (int m = n; m > 1; m >>= 1)
+        depth += 2;
+    engine_sort(arr, n, partition, sort_network_cutoff(), depth);
+    return 0;
+}
+
+/**
+ * @brief Sorts an array of n elements using quick sort with the fastest partition kernel the
+ *        CPU supports.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void quick_sort_vectorized(int *arr, int n) {
+    quick_sort_engine(arr, n, QUICK_SORT_AUTO);
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Checks one kernel on many sizes and value ranges: the split must be at the returned
+ *        index and no element may be lost or duplicated.
+ */
+static void check_kernel(partition_kernel_t partition, const char *name) {
+    enum { MAX_N = 300 };
+    int arr[MAX_N], before[MAX_N];
+
+    for (int trial = 0; trial < 100; trial++) {
+        for (int n = 0; n <= MAX_N; n++) {
+            int range = trial % 3 == 0 ? 4 : trial % 3 == 1 ? 1000 : INT_MAX;
+            for (int i = 0; i < n; i++) {
+                arr[i] = rand() % range - range / 2;
+            }
+            if (trial == 1 && n > 1) {
+                arr[0] = INT_MIN;
+                arr[n - 1] = INT_MAX;
+            }
+            int bound = n > 0 && trial % 5 ? arr[rand() % n] : (trial % 2 ? INT_MIN : INT_MAX);
+            memcpy(before, arr, n * sizeof(int));
+
+            int m = partition(arr, n, bound);
+            assert(m >= 0 && m <= n);
+            for (int i = 0; i < n; i++) {
+                assert((arr[i] < bound) == (i < m));
+            }
+            qsort(before, n, sizeof(int), compare_ints);
+            qsort(arr, n, sizeof(int), compare_ints);
+            assert(memcmp(arr, before, n * sizeof(int)) == 0);
+        }
+    }
+    printf("%s kernel ok\n", name);
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Opens a counter of this process's user-space branch misses.
+ *
+ * @return A file descriptor, or -1 where perf events are unavailable (other systems,
+ *         containers, perf_event_paranoid too high).
+ */
+static int branch_miss_counter(void) {
+#ifdef QUICK_SORT_PERF
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void counter_start(int fd) {
+#ifdef QUICK_SORT_PERF
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+/**
+ * @return The count since counter_start(), or -1 without a counter.
+ */
+static long long counter_stop(int fd) {
+    long long count = -1;
+#ifdef QUICK_SORT_PERF
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+            count = -1;
+    }
+#else
+    (void)fd;
+#endif
+    return count;
+}
+
+/**
+ * @brief One configuration of the benchmark; mode is ignored when legacy is set.
+ */
+typedef struct {
+    const char *name;
+    quick_sort_mode_t mode;
+    int legacy; /**< Runs quick_sort_simple(), the original one-branch-per-element partition. */
+} bench_t;
+
+/**
+ * @brief Driver code to demonstrate quick_sort_engine and check every kernel this CPU can run.
+ *
+ * Also benchmarks every mode and quick_sort_simple() on the same random array, printing the
+ * time and, where perf events are available, the number of branch misses.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {64, 34, 25, 12, 22, 11, 90, 5, -7};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    quick_sort_vectorized(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-7, 5, 11, 12, 22, 25, 34, 64, 90};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+    assert(quick_sort_engine(arr1, n1, QUICK_SORT_MODE_COUNT) == -1);
+    assert(quick_sort_engine(NULL, 0, QUICK_SORT_SCALAR) == 0);
+
+    srand(41);
+    check_kernel(partition_scalar, "scalar");
+    check_kernel(partition_branchless, "branchless");
+#ifdef QUICK_SORT_X86
+    if (__builtin_cpu_supports("avx2"))
+        check_kernel(partition_avx2, "avx2");
+    if (__builtin_cpu_supports("avx512f"))
+        check_kernel(partition_avx512, "avx512");
+#endif
+
+    enum { N = 1000000 };
+    int *a = malloc(N * sizeof(int));
+    int *b = malloc(N * sizeof(int));
+    int *ref = malloc(N * sizeof(int));
+    assert(a != NULL && b != NULL && ref != NULL);
+
+    const bench_t bench[] = {
+        {"quick_sort_simple", QUICK_SORT_SCALAR, 1},
+        {"scalar", QUICK_SORT_SCALAR, 0},
+        {"branchless", QUICK_SORT_BRANCHLESS, 0},
+        {"vectorized", QUICK_SORT_VECTORIZED, 0},
+    };
+    int fd = branch_miss_counter();
+    if (fd < 0) {
+        printf("Branch-miss counter unavailable; reporting times only.\n");
+    }
+
+    // Random, few distinct values, sorted, reversed and all equal
+    for (int pattern = 0; pattern < 5; pattern++) {
+        for (int i = 0; i < N; i++) {
+            switch (pattern) {
+            case 0: a[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand()); break;
+            case 1: a[i] = rand() % 8; break;
+            case 2: a[i] = i; break;
+            case 3: a[i] = N - i; break;
+            default: a[i] = INT_MAX; break;
+            }
+        }
+        memcpy(ref, a, N * sizeof(int));
+        qsort(ref, N, sizeof(int), compare_ints);
+
+        for (size_t k = 0; k < sizeof(bench) / sizeof(bench[0]); k++) {
+            // quick_sort_simple() is quadratic on the ordered patterns
+            if (bench[k].legacy && pattern != 0) {
+                continue;
+            }
+            memcpy(b, a, N * sizeof(int));
+            counter_start(fd);
+            clock_t start = clock();
+            if (bench[k].legacy)
+                quick_sort_simple(b, N);
+            else
+                assert(quick_sort_engine(b, N, bench[k].mode) == 0);
+            double t = seconds_since(start);
+            long long misses = counter_stop(fd);
+            assert(memcmp(b, ref, N * sizeof(int)) == 0);
+            if (pattern == 0 && misses >= 0) {
+                printf("%d random ints, %-17s %.3fs, %lld branch misses\n", N, bench[k].name, t,
+                       misses);
+            } else if (pattern == 0) {
+                printf("%d random ints, %-17s %.3fs\n", N, bench[k].name, t);
+            }
+        }
+    }
+#ifdef QUICK_SORT_PERF
+    if (fd >= 0)
+        close(fd);
+#endif
+    free(a);
+    free(b);
+    free(ref);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,391 @@
+/**
+ * @file quick_sort_parallel.c
+ * @brief Implementation of a Parallel Dual-Pivot Quick Sort Algorithm.
+ *
+ * @details
+ * The three ranges produced by a dual-pivot partition are independent, so they are sorted as
+ * tasks on the work-stealing pool from sort_pool.c: the left and middle ranges are spawned
+ * and the right range is sorted by the current thread before joining.
+ *
+ * - **Pivots**: two values are taken from five evenly spaced samples (the second and fourth
+ *   smallest), so sorted and reverse-sorted input split evenly. The ranges are x <= p1,
+ *   p1 < x < p2 and x >= p2; when p1 == p2 they are x < p, x == p and x > p instead, and the
+ *   middle range is left alone. Either way every range is smaller than its parent, so runs
+ *   of duplicates cannot stall the recursion.
+ * - **Parallel partition**: at the top of the recursion a single partition pass would leave
+ *   all but one thread idle. Ranges of at least QUICK_SORT_PARALLEL_PARTITION_MIN elements
+ *   are therefore split into one chunk per thread; each chunk counts its three classes, a
+ *   prefix sum over (class, chunk) gives every chunk its output positions, and the chunks
+ *   scatter into an auxiliary array that is then copied back, all concurrently.
+ * - **Cutoffs**: ranges of QUICK_SORT_PARALLEL_GRAIN elements or fewer are sorted by the
+ *   sequential version of the same dual-pivot sort, which finishes segments of at most
+ *   sort_network_cutoff() elements with sort_network(). Past 2 * log2(n) levels a range goes
+ *   to heap_sort_bottom_up(), which bounds the worst case.
+ *
+ * The thread count comes from sort_pool_default() (one per CPU, or SORT_THREADS). If the
+ * auxiliary array cannot be allocated, every partition is done sequentially in place.
+ *
+ * @section Performance
+ * - Work: O(n log n)
+ * - Span: O(n / p + log^2 n) on p threads with parallel partitioning at the top levels.
+ * - Space Complexity: O(n) for the auxiliary array when n >= QUICK_SORT_PARALLEL_PARTITION_MIN,
+ *   O(log n) stack per thread otherwise.
+ *
+ * The sort is not stable.
+ *
+ * @reference
+ * - Vladimir Yaroslavskiy, "Dual-Pivot Quicksort", 2009.
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_pool.h"
+
+/** Ranges of this size or smaller are sorted sequentially. */
+#define QUICK_SORT_PARALLEL_GRAIN 16384
+/** Ranges of at least this size are partitioned by all threads together. */
+#define QUICK_SORT_PARALLEL_PARTITION_MIN (1 << 20)
+/** Upper bound on the number of chunks of a parallel partition. */
+#define QUICK_SORT_PARALLEL_MAX_CHUNKS 64
+
+/**
+ * @brief Arguments of one recursive sorting task.
+ */
+typedef struct {
+    sort_pool_t *pool;
+    int *arr;  /**< Range to sort. */
+    int *aux;  /**< Scratch range of the same size, or NULL to partition in place. */
+    int n;     /**< Number of elements. */
+    int depth; /**< Levels left before heap sort takes over. */
+} pqsort_job_t;
+
+/**
+ * @brief Arguments of one chunk of a parallel partition.
+ */
+typedef struct {
+    const int *src;
+    int *dst;
+    int n;
+    int low;    /**< Elements below low go left... */
+    int high;   /**< ...and elements above high go right. */
+    int pos[3]; /**< Class counts, then the first output position of each class. */
+} part_chunk_t;
+
+/**
+ * @brief Class of x: 0 (left, x < low), 1 (middle) or 2 (right, x > high).
+ *
+ * Needs low <= high + 1, which choose_bounds() guarantees.
+ */
+static inline int classify(int x, int low, int high) {
+    return (x >= low) + (x > high);
+}
+
+/**
+ * @brief Chooses the bounds of the middle range of n >= 6 elements.
+ *
+ * @param low Receives the smallest value of the middle range.
+ * @param high Receives the largest value of the middle range; the middle range is sorted
+ *             without further work if low >= high.
+ */
+static void choose_bounds(const int *arr, int n, int *low, int *high) {
+    int sample[5];
+    int step = n / 6;
+
+    for (int k = 0; k < 5; k++) {
+        int x = arr[step * (k + 1)];
+        int j = k;
+        while (j > 0 && sample[j - 1] > x) {
+            sample[j] = sample[j - 1];
+            j--;
+        }
+        sample[j] = x;
+    }
+
+    int p1 = sample[1], p2 = sample[3];
+    if (p1 < p2) {
+        // Neither bound can overflow: p1 < INT_MAX and p2 > INT_MIN
+        *low = p1 + 1;
+        *high = p2 - 1;
+    } else {
+        *low = p1;
+        *high = p1;
+    }
+}
+
+/**
+ * @brief Three-way partition of arr[0..n) in place, in one pass.
+ */
+static void partition_sequential(int *arr, int n, int low, int high, int *n_left, int *n_right) {
+    int lt = 0, i = 0, gt = n - 1;
+
+    while (i <= gt) {
+        int x = arr[i];
+        if (x < low) {
+            arr[i++] = arr[lt];
+            arr[lt++] = x;
+        } else if (x > high) {
+            arr[i] = arr[gt];
+            arr[gt--] = x;
+        } else {
+            i++;
+        }
+    }
+    *n_left = lt;
+    *n_right = n - 1 - gt;
+}
+
+/**
+ * @brief Task body: counts the three classes of one chunk.
+ */
+static void chunk_count(void *arg) {
+    part_chunk_t *c = arg;
+    int count[3] = {0, 0, 0};
+
+    for (int i = 0; i < c->n; i++) {
+        count[classify(c->src[i], c->low, c->high)]++;
+    }
+    memcpy(c->pos, count, sizeof(count));
+}
+
+/**
+ * @brief Task body: writes each element of one chunk to the next position of its class.
+ */
+static void chunk_scatter(void *arg) {
+    const part_chunk_t *c = arg;
+    int pos[3] = {c->pos[0], c->pos[1], c->pos[2]};
+
+    for (int i = 0; i < c->n; i++) {
+        int x = c->src[i];
+        c->dst[pos[classify(x, c->low, c->high)]++] = x;
+    }
+}
+
+/**
+ * @brief Task body: copies one chunk back.
+ */
+static void chunk_copy(void *arg) {
+    const part_chunk_t *c = arg;
+
+    memcpy(c->dst, c->src, c->n * sizeof(int));
+}
+
+/**
+ * @brief Runs fn on each of the chunks, spreading them over the pool.
+ */
+static void run_chunks(sort_pool_t *pool, void (*fn)(void *), part_chunk_t *chunk, int chunks) {
+    sort_task_t task[QUICK_SORT_PARALLEL_MAX_CHUNKS];
+
+    for (int c = 1; c < chunks; c++) {
+        sort_pool_spawn(pool, &task[c], fn, &chunk[c]);
+    }
+    fn(&chunk[0]);
+    for (int c = chunks - 1; c >= 1; c--) {
+        sort_pool_wait(pool, &task[c]);
+    }
+}
+
+/**
+ * @brief Three-way partition of arr[0..n) by all threads, through aux[0..n).
+ */
+static void partition_parallel(sort_pool_t *pool, int *arr, int *aux, int n, int low, int high,
+                               int *n_left, int *n_right) {
+    part_chunk_t chunk[QUICK_SORT_PARALLEL_MAX_CHUNKS];
+    int chunks = sort_pool_threads(pool);
+    if (chunks > QUICK_SORT_PARALLEL_MAX_CHUNKS)
+        chunks = QUICK_SORT_PARALLEL_MAX_CHUNKS;
+
+    for (int c = 0; c < chunks; c++) {
+        int begin = (int)((long long)n * c / chunks);
+        int end = (int)((long long)n * (c + 1) / chunks);
+        chunk[c].src = arr + begin;
+        chunk[c].dst = aux;
+        chunk[c].n = end - begin;
+        chunk[c].low = low;
+        chunk[c].high = high;
+    }
+    run_chunks(pool, chunk_count, chunk, chunks);
+
+    // Class by class, chunk by chunk, so that every class ends up contiguous
+    int sum = 0;
+    for (int k = 0; k < 3; k++) {
+        for (int c = 0; c < chunks; c++) {
+            int count = chunk[c].pos[k];
+            chunk[c].pos[k] = sum;
+            sum += count;
+        }
+    }
+    *n_left = chunk[0].pos[1];
+    *n_right = n - chunk[0].pos[2];
+    run_chunks(pool, chunk_scatter, chunk, chunks);
+
+    for (int c = 0; c < chunks; c++) {
+        int begin = (int)(chunk[c].src - arr);
+        chunk[c].dst = arr + begin;
+        chunk[c].src = aux + begin;
+    }
+    run_chunks(pool, chunk_copy, chunk, chunks);
+}
+
+/**
+ * @brief Sequential dual-pivot quick sort of arr[0..n) with the given depth budget.
+ */
+static void dual_pivot_sort(int *arr, int n, int depth) {
+    int cutoff = sort_network_cutoff();
+
+    while (n > cutoff) {
+        if (depth-- == 0) {
+            heap_sort_bottom_up(arr, n);
+            return;
+        }
+        int low, high, n_left, n_right;
+        choose_bounds(arr, n, &low, &high);
+        partition_sequential(arr, n, low, high, &n_left, &n_right);
+
+        dual_pivot_sort(arr, n_left, depth);
+        if (low < high) {
+            dual_pivot_sort(arr + n_left, n - n_left - n_right, depth);
+        }
+        arr += n - n_right;
+        n = n_right;
+    }
+    sort_network(arr, n);
+}
+
+/**
+ * @brief Task body: sorts job->arr[0..n), forking the left and middle ranges.
+ */
+static void pqsort(void *arg) {
+    const pqsort_job_t *job = arg;
+    int *arr = job->arr;
+    int n = job->n;
+
+    if (n <= QUICK_SORT_PARALLEL_GRAIN || job->depth == 0) {
+        dual_pivot_sort(arr, n, job->depth);
+        return;
+    }
+
+    int low, high, n_left, n_right;
+    choose_bounds(arr, n, &low, &high);
+    if (job->aux != NULL && n >= QUICK_SORT_PARALLEL_PARTITION_MIN) {
+        partition_parallel(job->pool, arr, job->aux, n, low, high, &n_left, &n_right);
+    } else {
+        partition_sequential(arr, n, low, high, &n_left, &n_right);
+    }
+
+    int n_middle = n - n_left - n_right;
+    int *aux_middle = job->aux != NULL ? job->aux + n_left : NULL;
+    int *aux_right = job->aux != NULL ? job->aux + n - n_right : NULL;
+    pqsort_job_t left = {job->pool, arr, job->aux, n_left, job->depth - 1};
+    pqsort_job_t middle = {job->pool, arr + n_left, aux_middle, n_middle, job->depth - 1};
+    pqsort_job_t right = {job->pool, arr + n - n_right, aux_right, n_right, job->depth - 1};
+    sort_task_t left_task, middle_task;
+    int middle_sorted = low >= high;
+
+    sort_pool_spawn(job->pool, &left_task, pqsort, &left);
+    if (!middle_sorted) {
+        sort_pool_spawn(job->pool, &middle_task, pqsort, &middle);
+    }
+    pqsort(&right);
+    if (!middle_sorted) {
+        sort_pool_wait(job->pool, &middle_task);
+    }
+    sort_pool_wait(job->pool, &left_task);
+}
+
+/**
+ * @brief Sorts an array of n elements using parallel dual-pivot quick sort.
+ *
+ * Arrays of at most QUICK_SORT_PARALLEL_GRAIN elements are sorted on the calling thread.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void quick_sort_parallel(int *arr, int n) {
+    int depth = 0;
+    for (int m = n; m > 1; m >>= 1)
+        depth += 2;
+
+    if (n <= QUICK_SORT_PARALLEL_GRAIN) {
+        dual_pivot_sort(arr, n, depth);
+        return;
+    }
+
+    sort_pool_t *pool = sort_pool_default();
+    int *aux = NULL;
+    if (n >= QUICK_SORT_PARALLEL_PARTITION_MIN && sort_pool_threads(pool) > 1) {
+        aux = malloc(n * sizeof(int));
+    }
+
+    pqsort_job_t job = {pool, arr, aux, n, depth};
+    pqsort(&job);
+    free(aux);
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Driver code to demonstrate the quick_sort_parallel function.
+ *
+ * Sorts large inputs of several shapes on a pool of four threads by default, enough for both
+ * the parallel partition and the task recursion to take part.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    setenv("SORT_THREADS", "4", 0);
+
+    int arr1[] = {4, 9, 4, 4, 2, 3, 4, 9, 2, 9};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    quick_sort_parallel(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {2, 2, 3, 4, 4, 4, 4, 9, 9, 9};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    enum { N = 3 * QUICK_SORT_PARALLEL_PARTITION_MIN };
+    int *big = malloc(N * sizeof(int));
+    int *ref = malloc(N * sizeof(int));
+    assert(big != NULL && ref != NULL);
+
+    // Random, two values, few distinct values, sorted, reversed, all equal and organ pipe
+    srand(43);
+    for (int pattern = 0; pattern < 7; pattern++) {
+        for (int i = 0; i < N; i++) {
+            switch (pattern) {
+            case 0: big[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand()); break;
+            case 1: big[i] = rand() % 2 ? INT_MAX : INT_MIN; break;
+            case 2: big[i] = rand() % 100; break;
+            case 3: big[i] = i; break;
+            case 4: big[i] = N - i; break;
+            case 5: big[i] = 7; break;
+            default: big[i] = i < N / 2 ? i : N - i; break;
+            }
+        }
+        memcpy(ref, big, N * sizeof(int));
+        qsort(ref, N, sizeof(int), compare_ints);
+        quick_sort_parallel(big, N);
+        assert(memcmp(big, ref, N * sizeof(int)) == 0);
+    }
+    free(big);
+    free(ref);
+
+    printf("Sorted with %d threads.\n", sort_pool_threads(sort_pool_default()));
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -14,38 +14,14 @@
  * - Space Complexity: O(log n) - due to the recursion stack.
  *
  * Quick sort is generally faster than other O(n log n) algorithms and is widely used in practice for large data sets.
+ *
+ * Segments of at most sort_network_cutoff() elements are finished with sort_network().
  */
 
 #include <stdio.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param len The number of elements in the array.
- */
-void printf_array(int *arr, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
-
-/**
- * @brief Swaps two elements in an array.
- * 
- * This function swaps the values of two elements in the array.
- * 
- * @param a Pointer to the first element.
- * @param b Pointer to the second element.
- */
-void swap(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
+#include "sort.h"
+#include "sort_internal.h"
 
 /**
  * @brief Partitions the array for quick sort.
@@ -58,17 +34,17 @@ void swap(int *a, int *b) {
  * @param high The ending index of the array segment to be partitioned.
  * @return int The index of the pivot element after partitioning.
  */
-int partition(int *arr, int low, int high) {
+static int partition(int *arr, int low, int high) {
     int pivot = arr[high];
     int i = (low - 1);
 
     for (int j = low; j < high; j++) {
         if (arr[j] < pivot) {
             i++;
-            swap(&arr[i], &arr[j]);
+            sort_swap(&arr[i], &arr[j]);
         }
     }
-    swap(&arr[i + 1], &arr[high]);
+    sort_swap(&arr[i + 1], &arr[high]);
     return (i + 1);
 }
 
@@ -82,7 +58,12 @@ int partition(int *arr, int low, int high) {
  * @param low The starting index of the array segment to be sorted.
  * @param high The ending index of the array segment to be sorted.
  */
-void quick_sort(int *arr, int low, int high) {
+static void quick_sort(int *arr, int low, int high) {
+    // Small segments go to the sorting network (SIMD when the CPU has it)
+    if (high - low + 1 <= sort_network_cutoff()) {
+        sort_network(arr + low, high - low + 1);
+        return;
+    }
     if (low < high) {
         int pi = partition(arr, low, high);
 
@@ -91,6 +72,17 @@ void quick_sort(int *arr, int low, int high) {
     }
 }
 
+/**
+ * @brief Sorts an array of n elements using quick sort.
+ * 
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void quick_sort_simple(int *arr, int n) {
+    quick_sort(arr, 0, n - 1);
+}
+
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the quick sort algorithm.
  * 
@@ -106,11 +98,10 @@ int main() {
     int n = sizeof(unsorted_array) / sizeof(unsorted_array[0]);
 
     // Sort the array using quick sort
-    quick_sort(unsorted_array, 0, n - 1);
+    quick_sort_simple(unsorted_array, n);
     // Print the sorted array
-    printf_array(unsorted_array, n);
+    sort_print_array(unsorted_array, n);
 
     return 0;
 }
-
-
+#endif /* SORT_DEMO */
@@ -18,34 +18,8 @@
 
 #include <stdio.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param len The number of elements in the array.
- */
-void printf_array(int *arr, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
-
-/**
- * @brief Swaps two elements in an array.
- * 
- * This function swaps the values of two elements in the array.
- * 
- * @param a Pointer to the first element.
- * @param b Pointer to the second element.
- */
-void swap(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
+#include "sort.h"
+#include "sort_internal.h"
 
 /**
  * @brief Partitions the array for three-way quick sort.
@@ -59,7 +33,7 @@ void swap(int *a, int *b) {
  * @param lt Pointer to the index of the end of the 'less than pivot' segment.
  * @param gt Pointer to the index of the start of the 'greater than pivot' segment.
  */
-void three_way_partition(int *arr, int low, int high, int *lt, int *gt) {
+void sort_three_way_partition(int *arr, int low, int high, int *lt, int *gt) {
     int pivot = arr[low];
     int i = low;
     *lt = low;
@@ -67,11 +41,11 @@ void three_way_partition(int *arr, int low, int high, int *lt, int *gt) {
 
     while (i <= *gt) {
         if (arr[i] < pivot) {
-            swap(&arr[i], &arr[*lt]);
+            sort_swap(&arr[i], &arr[*lt]);
             (*lt)++;
             i++;
         } else if (arr[i] > pivot) {
-            swap(&arr[i], &arr[*gt]);
+            sort_swap(&arr[i], &arr[*gt]);
             (*gt)--;
         } else {
             i++;
@@ -89,16 +63,27 @@ void three_way_partition(int *arr, int low, int high, int *lt, int *gt) {
  * @param low The starting index of the array segment to be sorted.
  * @param high The ending index of the array segment to be sorted.
  */
-void quick_sort(int *arr, int low, int high) {
+static void quick_sort(int *arr, int low, int high) {
     if (low < high) {
         int lt, gt;
-        three_way_partition(arr, low, high, &lt, &gt);
+        sort_three_way_partition(arr, low, high, &lt, &gt);
 
         quick_sort(arr, low, lt - 1);
         quick_sort(arr, gt + 1, high);
     }
 }
 
+/**
+ * @brief Sorts an array of n elements using three-way quick sort.
+ * 
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void quick_sort_three_way(int *arr, int n) {
+    quick_sort(arr, 0, n - 1);
+}
+
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the three-way quick sort algorithm.
  * 
@@ -114,11 +99,10 @@ int main() {
     int n = sizeof(unsorted_array) / sizeof(unsorted_array[0]);
 
     // Sort the array using three-way quick sort
-    quick_sort(unsorted_array, 0, n - 1);
+    quick_sort_three_way(unsorted_array, n);
     // Print the sorted array
-    printf_array(unsorted_array, n);
+    sort_print_array(unsorted_array, n);
 
     return 0;
 }
-
-
+#endif /* SORT_DEMO */
@@ -0,0 +1,364 @@
+/**
+ * @file radix_sort_keys.c
+ * @brief Radix Sort for signed and unsigned 32/64-bit integers, floats and doubles.
+ *
+ * @details
+ * radix_sort_simple() only handles non-negative ints. Radix sort really operates on
+ * unsigned bit patterns, so the other key types are handled by mapping each value to an
+ * unsigned key whose numeric order is the order of the original values, sorting the keys
+ * with an 8-bit LSD radix sort, and mapping them back:
+ * - **Unsigned integers** are their own keys.
+ * - **Signed integers**: flipping the sign bit moves negative numbers below positive ones.
+ * - **IEEE floats and doubles**: for positive values, setting the sign bit is enough since
+ *   the exponent and mantissa already compare as an unsigned integer. Negative values are
+ *   stored as sign and magnitude, so all of their bits are inverted, which both moves them
+ *   below the positives and reverses their order.
+ *
+ * For floating point this gives the IEEE totalOrder: -NaN < -inf < ... < -0.0 < +0.0 < ...
+ * < +inf < +NaN.
+ *
+ * The passes are generated from the same SORT_DEFINE_RADIX_LSD_() body as radix_sort_lsd(),
+ * once per key width. Each pass is skipped when every key has the same byte at that position,
+ * so small integers stored in 64-bit keys cost about as much as 32-bit ones.
+ *
+ * Integer keys are transformed in place and sorted against a single auxiliary buffer.
+ * Floating point keys are first copied into an integer key array (which keeps the code free
+ * of type punning through pointers), so they use two buffers.
+ *
+ * @section Performance
+ * - Time Complexity: O(w / 8 * n) for w-bit keys.
+ * - Space Complexity: O(n) - one auxiliary buffer (two for floating point keys).
+ *
+ * The sorts are stable. If memory cannot be allocated they fall back to qsort().
+ *
+ * @reference
+ * - Michael Herf, "Radix Tricks", 2001.
+ * - IEEE 754-2008, section 5.10 (totalOrder).
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Key arrays of this size or smaller are sorted with insertion sort. */
+#define RADIX_SORT_KEYS_THRESHOLD 64
+
+static inline uint32_t key_from_i32(int32_t value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+static inline int32_t i32_from_key(uint32_t key) {
+    return (int32_t)(key ^ 0x80000000u);
+}
+
+static inline uint64_t key_from_i64(int64_t value) {
+    return (uint64_t)value ^ 0x8000000000000000u;
+}
+
+static inline int64_t i64_from_key(uint64_t key) {
+    return (int64_t)(key ^ 0x8000000000000000u);
+}
+
+static inline uint32_t key_from_float(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+static inline float float_from_key(uint32_t key) {
+    uint32_t bits = (key & 0x80000000u) ? key ^ 0x80000000u : ~key;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint64_t key_from_double(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000u) ? ~bits : bits | 0x8000000000000000u;
+}
+
+static inline double double_from_key(uint64_t key) {
+    uint64_t bits = (key & 0x8000000000000000u) ? key ^ 0x8000000000000000u : ~key;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* qsort() comparators on the transformed keys, used only when allocation fails. */
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_i64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_float(const void *a, const void *b) {
+    uint32_t x = key_from_float(*(const float *)a), y = key_from_float(*(const float *)b);
+    return (x > y) - (x < y);
+}
+
+static int compare_double(const void *a, const void *b) {
+    uint64_t x = key_from_double(*(const double *)a), y = key_from_double(*(const double *)b);
+    return (x > y) - (x < y);
+}
+
+#define RADIX_BITS(key) (key)
+
+SORT_DEFINE_RADIX_LSD_(lsd_passes_u32, uint32_t, char, RADIX_BITS, 0)
+SORT_DEFINE_RADIX_LSD_(lsd_passes_u64, uint64_t, char, RADIX_BITS, 0)
+
+/**
+ * @brief Defines lsd_sort_u<bits>(keys, buf, n), which sorts unsigned keys of that width with
+ *        8-bit LSD passes, leaving the result in keys.
+ *
+ * buf is a buffer of n keys, or NULL if n <= RADIX_SORT_KEYS_THRESHOLD.
+ */
+#define RADIX_SORT_KEYS_DEFINE(bits)                                                           \
+    SORT_DEFINE_INSERTION_(lsd_small_u##bits, uint##bits##_t, char, SORT_LESS, 0)              \
+                                                                                               \
+    static void lsd_sort_u##bits(uint##bits##_t *keys, uint##bits##_t *buf, int n) {           \
+        if (n <= RADIX_SORT_KEYS_THRESHOLD) {                                                  \
+            lsd_small_u##bits##_insertion(keys, NULL, n < 0 ? 0 : n);                          \
+            return;                                                                            \
+        }                                                                                      \
+        unsigned count[bits / 8 * 256] = {0};                                                  \
+        lsd_passes_u##bits(keys, NULL, buf, NULL, n, 8, count);                                \
+    }
+
+RADIX_SORT_KEYS_DEFINE(32)
+RADIX_SORT_KEYS_DEFINE(64)
+
+/**
+ * @brief Sorts an array of n unsigned 32-bit integers using radix sort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_u32(uint32_t *arr, int n) {
+    uint32_t *buf = NULL;
+
+    if (n > RADIX_SORT_KEYS_THRESHOLD && (buf = malloc(n * sizeof(uint32_t))) == NULL) {
+        qsort(arr, n, sizeof(uint32_t), compare_u32);
+        return;
+    }
+    lsd_sort_u32(arr, buf, n);
+    free(buf);
+}
+
+/**
+ * @brief Sorts an array of n signed 32-bit integers using radix sort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_i32(int32_t *arr, int n) {
+    uint32_t *keys = (uint32_t *)arr; // Same-width signed/unsigned access is allowed
+    uint32_t *buf = NULL;
+
+    if (n > RADIX_SORT_KEYS_THRESHOLD && (buf = malloc(n * sizeof(uint32_t))) == NULL) {
+        qsort(arr, n, sizeof(int32_t), compare_i32);
+        return;
+    }
+    for (int i = 0; i < n; i++) keys[i] = key_from_i32(arr[i]);
+    lsd_sort_u32(keys, buf, n);
+    for (int i = 0; i < n; i++) arr[i] = i32_from_key(keys[i]);
+    free(buf);
+}
+
+/**
+ * @brief Sorts an array of n unsigned 64-bit integers using radix sort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_u64(uint64_t *arr, int n) {
+    uint64_t *buf = NULL;
+
+    if (n > RADIX_SORT_KEYS_THRESHOLD && (buf = malloc(n * sizeof(uint64_t))) == NULL) {
+        qsort(arr, n, sizeof(uint64_t), compare_u64);
+        return;
+    }
+    lsd_sort_u64(arr, buf, n);
+    free(buf);
+}
+
+/**
+ * @brief Sorts an array of n signed 64-bit integers using radix sort.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_i64(int64_t *arr, int n) {
+    uint64_t *keys = (uint64_t *)arr;
+    uint64_t *buf = NULL;
+
+    if (n > RADIX_SORT_KEYS_THRESHOLD && (buf = malloc(n * sizeof(uint64_t))) == NULL) {
+        qsort(arr, n, sizeof(int64_t), compare_i64);
+        return;
+    }
+    for (int i = 0; i < n; i++) keys[i] = key_from_i64(arr[i]);
+    lsd_sort_u64(keys, buf, n);
+    for (int i = 0; i < n; i++) arr[i] = i64_from_key(keys[i]);
+    free(buf);
+}
+
+/**
+ * @brief Sorts an array of n floats using radix sort, in IEEE totalOrder.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_float(float *arr, int n) {
+    if (n < 2) {
+        return;
+    }
+
+    uint32_t *keys = malloc(2 * (size_t)n * sizeof(uint32_t));
+    if (keys == NULL) {
+        qsort(arr, n, sizeof(float), compare_float);
+        return;
+    }
+    for (int i = 0; i < n; i++) keys[i] = key_from_float(arr[i]);
+    lsd_sort_u32(keys, keys + n, n);
+    for (int i = 0; i < n; i++) arr[i] = float_from_key(keys[i]);
+    free(keys);
+}
+
+/**
+ * @brief Sorts an array of n doubles using radix sort, in IEEE totalOrder.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_double(double *arr, int n) {
+    if (n < 2) {
+        return;
+    }
+
+    uint64_t *keys = malloc(2 * (size_t)n * sizeof(uint64_t));
+    if (keys == NULL) {
+        qsort(arr, n, sizeof(double), compare_double);
+        return;
+    }
+    for (int i = 0; i < n; i++) keys[i] = key_from_double(arr[i]);
+    lsd_sort_u64(keys, keys + n, n);
+    for (int i = 0; i < n; i++) arr[i] = double_from_key(keys[i]);
+    free(keys);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Returns a random 64-bit pattern.
+ */
+static uint64_t random_bits(void) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits = (bits << 16) ^ (uint64_t)(rand() & 0xffff);
+    }
+    return bits;
+}
+
+/**
+ * @brief Driver code to demonstrate the typed radix sorts.
+ *
+ * Each key type is sorted with its radix sort and with qsort(), and the results compared.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {170, -45, 75, 90, -802, 24, 2, 66};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    radix_sort_i32((int32_t *)arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-802, -45, 2, 24, 66, 75, 90, 170};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    float arr2[] = {3.5f, -0.0f, -INFINITY, 0.0f, 1e-40f, -2.25f, INFINITY, -1e30f};
+    int n2 = sizeof(arr2) / sizeof(arr2[0]);
+    radix_sort_float(arr2, n2);
+    float expected2[] = {-INFINITY, -1e30f, -2.25f, -0.0f, 0.0f, 1e-40f, 3.5f, INFINITY};
+    for (int i = 0; i < n2; i++) {
+        assert(arr2[i] == expected2[i] && signbit(arr2[i]) == signbit(expected2[i]));
+    }
+
+    enum { N = 20000 };
+    static uint32_t u32[N], u32_ref[N];
+    static int32_t i32[N], i32_ref[N];
+    static uint64_t u64[N], u64_ref[N];
+    static int64_t i64[N], i64_ref[N];
+    static float f32[N], f32_ref[N];
+    static double f64[N], f64_ref[N];
+
+    srand(17);
+    for (int n = 0; n <= N; n = n * 3 + 1) {
+        for (int i = 0; i < n; i++) {
+            uint64_t bits = random_bits();
+            u32[i] = (uint32_t)bits;
+            i32[i] = (int32_t)(bits >> 32);
+            u64[i] = (i % 2) ? bits : bits >> 40; // Mix of wide and narrow keys
+            i64[i] = (int64_t)(bits ^ (bits << 7));
+            f32[i] = (float)((int32_t)bits) / 1024.0f;
+            f64[i] = (double)(int64_t)bits * 1e-9;
+        }
+        memcpy(u32_ref, u32, sizeof(u32));
+        memcpy(i32_ref, i32, sizeof(i32));
+        memcpy(u64_ref, u64, sizeof(u64));
+        memcpy(i64_ref, i64, sizeof(i64));
+        memcpy(f32_ref, f32, sizeof(f32));
+        memcpy(f64_ref, f64, sizeof(f64));
+
+        radix_sort_u32(u32, n);
+        radix_sort_i32(i32, n);
+        radix_sort_u64(u64, n);
+        radix_sort_i64(i64, n);
+        radix_sort_float(f32, n);
+        radix_sort_double(f64, n);
+        qsort(u32_ref, n, sizeof(uint32_t), compare_u32);
+        qsort(i32_ref, n, sizeof(int32_t), compare_i32);
+        qsort(u64_ref, n, sizeof(uint64_t), compare_u64);
+        qsort(i64_ref, n, sizeof(int64_t), compare_i64);
+        qsort(f32_ref, n, sizeof(float), compare_float);
+        qsort(f64_ref, n, sizeof(double), compare_double);
+
+        assert(memcmp(u32, u32_ref, n * sizeof(uint32_t)) == 0);
+        assert(memcmp(i32, i32_ref, n * sizeof(int32_t)) == 0);
+        assert(memcmp(u64, u64_ref, n * sizeof(uint64_t)) == 0);
+        assert(memcmp(i64, i64_ref, n * sizeof(int64_t)) == 0);
+        assert(memcmp(f32, f32_ref, n * sizeof(float)) == 0);
+        assert(memcmp(f64, f64_ref, n * sizeof(double)) == 0);
+        for (int i = 1; i < n; i++) {
+            assert(i32[i - 1] <= i32[i] && i64[i - 1] <= i64[i]);
+            assert(f32[i - 1] <= f32[i] && f64[i - 1] <= f64[i]);
+        }
+    }
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,179 @@
+/**
+ * @file radix_sort_lsd.c
+ * @brief Implementation of a binary-digit LSD Radix Sort.
+ *
+ * @details
+ * radix_sort_simple.c sorts by decimal digits, which costs up to ten passes over 32-bit keys
+ * and a division and modulo per element per pass. This version treats each key as a 32-bit
+ * unsigned number split into fixed-width binary digits (8 bits by default, any width from 1
+ * to 16 on request), so every digit is a shift and a mask:
+ * - **Signed keys**: the sign bit is flipped before digits are taken, which maps INT_MIN..INT_MAX
+ *   onto 0..UINT32_MAX in order, so negative numbers need no special case.
+ * - **One histogram pass**: the counts of every digit position are gathered in a single read
+ *   of the input instead of one read per pass.
+ * - **Trivial passes are skipped**: if all keys share the same value of a digit (for example
+ *   the upper bytes of small numbers), that pass would only copy the data, so it is dropped.
+ * - **Ping-pong buffers**: each pass scatters from one buffer into the other and the roles
+ *   swap; the result is copied back only if it ended up in the auxiliary buffer.
+ *
+ * With 8-bit digits a 32-bit key takes four passes, with 11-bit digits three and with 16-bit
+ * digits two; wider digits mean fewer passes but larger histograms and a more scattered write
+ * pattern, so they only pay off for large inputs.
+ *
+ * @section Performance
+ * - Time Complexity: O(p * n + p * 2^b) for p = ceil(32 / b) passes of b-bit digits.
+ * - Space Complexity: O(n + p * 2^b)
+ *
+ * The sort is stable.
+ *
+ * @reference
+ * - Pierre Terdiman, "Radix Sort Revisited", 2000.
+ * - Michael Herf, "Radix Tricks", 2001.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Arrays of this size or smaller are sorted with insertion sort. */
+#define RADIX_SORT_LSD_THRESHOLD 64
+/** Arrays of at least this size use 11-bit digits when the width is chosen automatically. */
+#define RADIX_SORT_LSD_WIDE_MIN (1 << 20)
+/** Widest digit accepted, which bounds a histogram at 65536 counters. */
+#define RADIX_SORT_LSD_MAX_BITS 16
+
+/**
+ * @brief Maps an int to an unsigned key with the same ordering.
+ */
+static inline uint32_t radix_key(int value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+// The histogram and scatter passes, shared with the radix engine of sort_kv()
+SORT_DEFINE_RADIX_LSD_(radix_lsd, int, int, radix_key, 0)
+
+/**
+ * @brief Sorts an array of n elements using LSD radix sort with digits of the given width.
+ *
+ * Falls back to intro_sort() if the buffers cannot be allocated.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param digit_bits Bits per digit, from 1 to 16, or 0 to choose based on n.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int radix_sort_lsd_bits(int *arr, int n, int digit_bits) {
+    if (n < 0 || (arr == NULL && n > 0) || digit_bits < 0 || digit_bits > RADIX_SORT_LSD_MAX_BITS) {
+        return -1;
+    }
+    if (n <= RADIX_SORT_LSD_THRESHOLD) {
+        insertion_sort_iterative(arr, n);
+        return 0;
+    }
+    if (digit_bits == 0) {
+        digit_bits = n >= RADIX_SORT_LSD_WIDE_MIN ? 11 : 8;
+    }
+
+    int passes = (32 + digit_bits - 1) / digit_bits;
+    size_t radix = (size_t)1 << digit_bits;
+    unsigned *count = calloc(passes * radix, sizeof(unsigned));
+    int *buf = malloc(n * sizeof(int));
+
+    if (count == NULL || buf == NULL) {
+        free(count);
+        free(buf);
+        intro_sort(arr, n);
+        return 0;
+    }
+
+    radix_lsd(arr, NULL, buf, NULL, n, digit_bits, count);
+    free(buf);
+    free(count);
+    return 0;
+}
+
+/**
+ * @brief Sorts an array of n elements using LSD radix sort with an automatic digit width.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_lsd(int *arr, int n) {
+    radix_sort_lsd_bits(arr, n, 0);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Checks that an array is sorted in non-decreasing order.
+ *
+ * @param arr The array to check.
+ * @param n The size of the array.
+ */
+static void assert_sorted(const int *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        assert(arr[i - 1] <= arr[i]);
+    }
+}
+
+/**
+ * @brief Driver code to demonstrate the radix_sort_lsd and radix_sort_lsd_bits functions.
+ *
+ * Runs every digit width over random keys (including negative numbers and the extremes of
+ * int) and over small keys where most passes are skipped.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {170, -45, 75, 90, -802, 24, 2, 66};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    radix_sort_lsd(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-802, -45, 2, 24, 66, 75, 90, 170};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    assert(radix_sort_lsd_bits(arr1, n1, 17) == -1);
+    assert(radix_sort_lsd_bits(arr1, -1, 8) == -1);
+
+    enum { N = 100000 };
+    static int big[N];
+    srand(13);
+
+    for (int bits = 0; bits <= RADIX_SORT_LSD_MAX_BITS; bits++) {
+        long long sum_before = 0, sum_after = 0;
+        for (int i = 0; i < N; i++) {
+            big[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+        }
+        big[0] = INT_MIN;
+        big[1] = INT_MAX;
+        for (int i = 0; i < N; i++) sum_before += big[i];
+
+        assert(radix_sort_lsd_bits(big, N, bits) == 0);
+        assert_sorted(big, N);
+        assert(big[0] == INT_MIN && big[N - 1] == INT_MAX);
+        for (int i = 0; i < N; i++) sum_after += big[i];
+        assert(sum_before == sum_after);
+    }
+
+    for (int i = 0; i < N; i++) big[i] = rand() % 200;  // Only the lowest byte varies
+    radix_sort_lsd(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = -7;            // Every pass is skipped
+    radix_sort_lsd(big, N);
+    assert(big[0] == -7 && big[N - 1] == -7);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,365 @@
+/**
+ * @file radix_sort_parallel.c
+ * @brief Implementation of a Parallel MSD Radix Sort.
+ *
+ * @details
+ * Keys are split into four 8-bit digits (after flipping the sign bit, as in radix_sort_lsd.c)
+ * and sorted most significant digit first. One MSD step distributes a segment into 256
+ * buckets, after which every bucket is an independent sub-problem on the next digit, so the
+ * recursion parallelizes naturally on the work-stealing pool from sort_pool.c:
+ * - **Parallel partition**: segments of at least RADIX_SORT_PARALLEL_PARTITION_MIN elements
+ *   are cut into one chunk per thread. Each chunk builds its own histogram, the histograms are
+ *   combined into per-chunk write positions with a prefix sum (bucket by bucket, chunk by
+ *   chunk), and the chunks then scatter concurrently into disjoint ranges of the other buffer.
+ *   No atomics or locks are involved and the partition stays stable.
+ * - **Parallel recursion**: buckets of at least RADIX_SORT_PARALLEL_GRAIN elements are spawned
+ *   as tasks; smaller ones are sorted by the current thread.
+ * - **Small buckets**: buckets of RADIX_SORT_PARALLEL_THRESHOLD elements or fewer are finished
+ *   with insertion_sort_iterative() instead of another 256-bucket pass.
+ * - **Trivial digits**: if every key of a segment has the same digit, the scatter is skipped
+ *   and the segment moves on to the next digit, which keeps skewed inputs (for example small
+ *   non-negative numbers, which share their top bytes) from paying for empty passes.
+ *
+ * Like merge_sort_parallel.c, the sort ping-pongs between the array and one auxiliary buffer:
+ * every level scatters from one into the other, and only the leaves copy back when needed.
+ *
+ * The thread count comes from sort_pool_default() (one per CPU, or SORT_THREADS).
+ *
+ * @section Performance
+ * - Work: O(4 * n) plus O(256) per partitioned segment.
+ * - Span: O(n / p) for the top-level partition on p threads, after which buckets proceed
+ *   independently; in practice the sort becomes bound by memory bandwidth.
+ * - Space Complexity: O(n) - one auxiliary array.
+ *
+ * The sort is stable.
+ *
+ * @reference
+ * - Marek Kokot et al., "RADULS2: Sorting Large Arrays of Records", 2017.
+ * - Nadathur Satish et al., "Fast Sort on CPUs and GPUs: A Case for Bandwidth Oblivious
+ *   SIMD Sort", SIGMOD 2010.
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_pool.h"
+
+/** Buckets of this size or smaller are finished with insertion sort. */
+#define RADIX_SORT_PARALLEL_THRESHOLD 32
+/** Buckets of at least this size are sorted as separate tasks. */
+#define RADIX_SORT_PARALLEL_GRAIN 16384
+/** Segments of at least this size are partitioned by all threads together. */
+#define RADIX_SORT_PARALLEL_PARTITION_MIN (1 << 18)
+/** Upper bound on the number of chunks of a parallel partition. */
+#define RADIX_SORT_PARALLEL_MAX_CHUNKS 64
+
+#define RADIX_SORT_PARALLEL_BUCKETS 256
+
+/**
+ * @brief Arguments of one recursive sorting task.
+ */
+typedef struct {
+    sort_pool_t *pool;
+    int *a;     /**< Segment to sort. */
+    int *b;     /**< Scratch segment of the same size. */
+    int n;      /**< Number of elements. */
+    int shift;  /**< Position of the current digit; negative once all digits are used. */
+    int into_b; /**< Nonzero if the sorted result must end up in b instead of a. */
+} msd_job_t;
+
+/**
+ * @brief Arguments of one chunk of a parallel partition.
+ */
+typedef struct {
+    const int *src;
+    int *dst;
+    int n;
+    int shift;
+    unsigned *count; /**< Histogram of the chunk, then its write positions in dst. */
+} chunk_job_t;
+
+/**
+ * @brief Returns the digit of value at the given shift, with the sign bit flipped.
+ */
+static inline unsigned digit_of(int value, int shift) {
+    return (((uint32_t)value ^ 0x80000000u) >> shift) & 0xff;
+}
+
+/**
+ * @brief Task body: builds the histogram of one chunk.
+ */
+static void chunk_histogram(void *arg) {
+    const chunk_job_t *c = arg;
+
+    memset(c->count, 0, RADIX_SORT_PARALLEL_BUCKETS * sizeof(unsigned));
+    for (int i = 0; i < c->n; i++) {
+        c->count[digit_of(c->src[i], c->shift)]++;
+    }
+}
+
+/**
+ * @brief Task body: scatters one chunk to its precomputed write positions.
+ */
+static void chunk_scatter(void *arg) {
+    const chunk_job_t *c = arg;
+
+    for (int i = 0; i < c->n; i++) {
+        int value = c->src[i];
+        c->dst[c->count[digit_of(value, c->shift)]++] = value;
+    }
+}
+
+/**
+ * @brief Partitions a[0..n) into b by one digit, with all threads working on it.
+ *
+ * @param job The segment.
+ * @param start Receives the bucket boundaries: bucket d is b[start[d]..start[d + 1]).
+ * @return 1 if the segment was scattered, 0 if all keys share the digit (nothing is moved),
+ *         or -1 if memory for the histograms could not be allocated.
+ */
+static int partition_parallel(const msd_job_t *job, unsigned *start) {
+    int chunks = sort_pool_threads(job->pool);
+    if (chunks > RADIX_SORT_PARALLEL_MAX_CHUNKS)
+        chunks = RADIX_SORT_PARALLEL_MAX_CHUNKS;
+
+    unsigned *count = malloc((size_t)chunks * RADIX_SORT_PARALLEL_BUCKETS * sizeof(unsigned));
+    if (count == NULL) {
+        return -1;
+    }
+
+    chunk_job_t chunk[RADIX_SORT_PARALLEL_MAX_CHUNKS];
+    sort_task_t task[RADIX_SORT_PARALLEL_MAX_CHUNKS];
+    for (int c = 0; c < chunks; c++) {
+        int begin = (int)((long long)job->n * c / chunks);
+        int end = (int)((long long)job->n * (c + 1) / chunks);
+        chunk[c].src = job->a + begin;
+        chunk[c].dst = job->b;
+        chunk[c].n = end - begin;
+        chunk[c].shift = job->shift;
+        chunk[c].count = count + c * RADIX_SORT_PARALLEL_BUCKETS;
+    }
+
+    for (int c = 1; c < chunks; c++) {
+        sort_pool_spawn(job->pool, &task[c], chunk_histogram, &chunk[c]);
+    }
+    chunk_histogram(&chunk[0]);
+    for (int c = chunks - 1; c >= 1; c--) {
+        sort_pool_wait(job->pool, &task[c]);
+    }
+
+    // Bucket d of chunk c is written after bucket d of chunks 0..c-1, which keeps it stable
+    unsigned sum = 0;
+    for (int d = 0; d < RADIX_SORT_PARALLEL_BUCKETS; d++) {
+        start[d] = sum;
+        for (int c = 0; c < chunks; c++) {
+            unsigned temp = chunk[c].count[d];
+            chunk[c].count[d] = sum;
+            sum += temp;
+        }
+        if (sum - start[d] == (unsigned)job->n) {
+            free(count);
+            return 0;
+        }
+    }
+    start[RADIX_SORT_PARALLEL_BUCKETS] = sum;
+
+    for (int c = 1; c < chunks; c++) {
+        sort_pool_spawn(job->pool, &task[c], chunk_scatter, &chunk[c]);
+    }
+    chunk_scatter(&chunk[0]);
+    for (int c = chunks - 1; c >= 1; c--) {
+        sort_pool_wait(job->pool, &task[c]);
+    }
+
+    free(count);
+    return 1;
+}
+
+/**
+ * @brief Partitions a[0..n) into b by one digit on the calling thread.
+ *
+ * @param job The segment.
+ * @param start Receives the bucket boundaries, as in partition_parallel().
+ * @return 1 if the segment was scattered, 0 if all keys share the digit.
+ */
+static int partition_sequential(const msd_job_t *job, unsigned *start) {
+    unsigned count[RADIX_SORT_PARALLEL_BUCKETS] = {0};
+
+    for (int i = 0; i < job->n; i++) {
+        count[digit_of(job->a[i], job->shift)]++;
+    }
+    if (count[digit_of(job->a[0], job->shift)] == (unsigned)job->n) {
+        return 0;
+    }
+
+    unsigned sum = 0;
+    for (int d = 0; d < RADIX_SORT_PARALLEL_BUCKETS; d++) {
+        start[d] = sum;
+        unsigned temp = count[d];
+        count[d] = sum;
+        sum += temp;
+    }
+    start[RADIX_SORT_PARALLEL_BUCKETS] = sum;
+
+    for (int i = 0; i < job->n; i++) {
+        int value = job->a[i];
+        job->b[count[digit_of(value, job->shift)]++] = value;
+    }
+    return 1;
+}
+
+/**
+ * @brief Task body: sorts job->a[0..n) by the remaining digits, leaving the result in a or b.
+ */
+static void msd_sort(void *arg) {
+    msd_job_t job = *(const msd_job_t *)arg;
+    unsigned start[RADIX_SORT_PARALLEL_BUCKETS + 1];
+
+    for (;;) {
+        if (job.n <= RADIX_SORT_PARALLEL_THRESHOLD || job.shift < 0) {
+            // Keys left after the last digit are all equal and need no sorting
+            if (job.shift >= 0) {
+                insertion_sort_iterative(job.a, job.n);
+            }
+            if (job.into_b) {
+                memcpy(job.b, job.a, job.n * sizeof(int));
+            }
+            return;
+        }
+
+        int scattered = -1;
+        if (job.n >= RADIX_SORT_PARALLEL_PARTITION_MIN && sort_pool_threads(job.pool) > 1) {
+            scattered = partition_parallel(&job, start);
+        }
+        if (scattered < 0) {
+            scattered = partition_sequential(&job, start);
+        }
+        if (scattered) {
+            break;
+        }
+        job.shift -= 8;
+    }
+
+    // The buckets are now in b; each sorts back towards a, so the target flips
+    msd_job_t child[RADIX_SORT_PARALLEL_BUCKETS];
+    sort_task_t task[RADIX_SORT_PARALLEL_BUCKETS];
+    int spawned[RADIX_SORT_PARALLEL_BUCKETS];
+    int num_spawned = 0;
+
+    for (int d = 0; d < RADIX_SORT_PARALLEL_BUCKETS; d++) {
+        int len = (int)(start[d + 1] - start[d]);
+        child[d].pool = job.pool;
+        child[d].a = job.b + start[d];
+        child[d].b = job.a + start[d];
+        child[d].n = len;
+        child[d].shift = job.shift - 8;
+        child[d].into_b = !job.into_b;
+        if (len >= RADIX_SORT_PARALLEL_GRAIN) {
+            sort_pool_spawn(job.pool, &task[d], msd_sort, &child[d]);
+            spawned[num_spawned++] = d;
+        }
+    }
+    for (int d = 0; d < RADIX_SORT_PARALLEL_BUCKETS; d++) {
+        if (child[d].n > 0 && child[d].n < RADIX_SORT_PARALLEL_GRAIN) {
+            msd_sort(&child[d]);
+        }
+    }
+    while (num_spawned > 0) {
+        sort_pool_wait(job.pool, &task[spawned[--num_spawned]]);
+    }
+}
+
+/**
+ * @brief Sorts an array of n elements using parallel MSD radix sort.
+ *
+ * Falls back to intro_sort() if the auxiliary buffer cannot be allocated.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void radix_sort_parallel(int *arr, int n) {
+    if (n <= RADIX_SORT_PARALLEL_THRESHOLD) {
+        insertion_sort_iterative(arr, n);
+        return;
+    }
+
+    int *aux = malloc(n * sizeof(int));
+    if (aux == NULL) {
+        intro_sort(arr, n);
+        return;
+    }
+
+    msd_job_t job = {sort_pool_default(), arr, aux, n, 24, 0};
+    msd_sort(&job);
+    free(aux);
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Driver code to demonstrate the radix_sort_parallel function.
+ *
+ * Compares the results with qsort() on uniform, skewed and duplicate-heavy inputs. The pool
+ * gets four threads unless SORT_THREADS says otherwise, so the MSD partition and the bucket
+ * tasks are spread over threads even on a small machine.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    setenv("SORT_THREADS", "4", 0);
+
+    int arr1[] = {170, -45, 75, 90, -802, 24, 2, 66};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    radix_sort_parallel(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-802, -45, 2, 24, 66, 75, 90, 170};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    enum { N = 2000000 };
+    int *big = malloc(N * sizeof(int));
+    int *ref = malloc(N * sizeof(int));
+    assert(big != NULL && ref != NULL);
+    srand(19);
+
+    for (int pattern = 0; pattern < 4; pattern++) {
+        for (int i = 0; i < N; i++) {
+            int r = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+            switch (pattern) {
+            case 0: big[i] = r; break;                          // Uniform over all of int
+            case 1: big[i] = r & 0xfffff; break;                // Top bytes shared
+            case 2: big[i] = (r & 0x7) - 4; break;              // A handful of values
+            default: big[i] = (r % 3 == 0) ? r : 1 << 20; break; // One huge bucket
+            }
+        }
+        big[0] = INT_MIN;
+        big[N - 1] = INT_MAX;
+        memcpy(ref, big, N * sizeof(int));
+
+        radix_sort_parallel(big, N);
+        qsort(ref, N, sizeof(int), compare_ints);
+        assert(memcmp(big, ref, N * sizeof(int)) == 0);
+    }
+    free(big);
+    free(ref);
+
+    printf("Sorted with %d threads.\n", sort_pool_threads(sort_pool_default()));
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "sort.h"
+
 /**
  * @brief Find the maximum value in an array.
  * 
@@ -50,7 +52,7 @@
  * @param n The size of the array.
  * @return The maximum value in the array.
  */
-int findMax(int arr[], int n) {
+static int findMax(int arr[], int n) {
     int max = arr[0]; // Initialize max with the first element
     for (int i = 1; i < n; i++) { // Iterate through the array
         if (arr[i] > max) { // Update max if current element is greater
@@ -67,7 +69,7 @@ int findMax(int arr[], int n) {
  * @param n The size of the array.
  * @param exp The exponent representing the digit position.
  */
-void countingSort(int arr[], int n, int exp) {
+static void countingSort(int arr[], int n, int exp) {
     int *output = (int *)malloc(n * sizeof(int)); // Output array
     int count[10] = {0}; // Count array for digits 0-9
 
@@ -101,7 +103,7 @@ void countingSort(int arr[], int n, int exp) {
  * @param arr The array to be sorted.
  * @param n The size of the array.
  */
-void radixSort(int arr[], int n) {
+void radix_sort_simple(int arr[], int n) {
     int max = findMax(arr, n); // Find the maximum value in the array
 
     // Perform counting sort for each digit (exponentially increasing)
@@ -110,23 +112,11 @@ void radixSort(int arr[], int n) {
     }
 }
 
+#ifdef SORT_DEMO
 /**
- * @brief Print an array.
- * 
- * @param arr The array to be printed.
- * @param n The size of the array.
- */
-void printArray(int arr[], int n) {
-    for (int i = 0; i < n; i++) { // Iterate through the array
-        printf("%d ", arr[i]); // Print each element
-    }
-    printf("\n"); // Print a new line
-}
-
-/**
- * @brief Driver code to demonstrate the radixSort function.
+ * @brief Driver code to demonstrate the radix_sort_simple function.
  * 
- * This function creates multiple test cases and calls the radixSort function to sort arrays.
+ * This function creates multiple test cases and calls the radix_sort_simple function to sort arrays.
  * It then prints and verifies the sorted arrays using assertions.
  * 
  * @return 0 on successful execution.
@@ -134,8 +124,8 @@ void printArray(int arr[], int n) {
 int main() {
     int arr1[] = {170, 45, 75, 90, 802, 24, 2, 66}; // Test case 1
     int n1 = sizeof(arr1) / sizeof(arr1[0]); // Calculate the size of the array
-    radixSort(arr1, n1); // Sort the array
-    printArray(arr1, n1); // Print the sorted array
+    radix_sort_simple(arr1, n1); // Sort the array
+    sort_print_array(arr1, n1); // Print the sorted array
     int expected1[] = {2, 24, 45, 66, 75, 90, 170, 802}; // Expected result
     for (int i = 0; i < n1; i++) {
         assert(arr1[i] == expected1[i]); // Assert to verify the result
@@ -143,8 +133,8 @@ int main() {
 
     int arr2[] = {4, 3, 1, 4, 2, 7, 9, 8}; // Test case 2
     int n2 = sizeof(arr2) / sizeof(arr2[0]); // Calculate the size of the array
-    radixSort(arr2, n2); // Sort the array
-    printArray(arr2, n2); // Print the sorted array
+    radix_sort_simple(arr2, n2); // Sort the array
+    sort_print_array(arr2, n2); // Print the sorted array
     int expected2[] = {1, 2, 3, 4, 4, 7, 8, 9}; // Expected result
     for (int i = 0; i < n2; i++) {
         assert(arr2[i] == expected2[i]); // Assert to verify the result
@@ -152,8 +142,8 @@ int main() {
 
     int arr3[] = {9, 8, 7, 6, 5, 4, 3, 2, 1}; // Test case 3
     int n3 = sizeof(arr3) / sizeof(arr3[0]); // Calculate the size of the array
-    radixSort(arr3, n3); // Sort the array
-    printArray(arr3, n3); // Print the sorted array
+    radix_sort_simple(arr3, n3); // Sort the array
+    sort_print_array(arr3, n3); // Print the sorted array
     int expected3[] = {1, 2, 3, 4, 5, 6, 7, 8, 9}; // Expected result
     for (int i = 0; i < n3; i++) {
         assert(arr3[i] == expected3[i]); // Assert to verify the result
@@ -163,3 +153,4 @@ int main() {
 
     return 0; // Return 0 to indicate successful execution
 }
+#endif /* SORT_DEMO */
@@ -25,20 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param length The number of elements in the array.
- */
-void printing_arrays(int * arr, int length){
-    for (int i = 0; i < length; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Sorts an array using selection sort algorithm.
@@ -50,7 +37,7 @@ void printing_arrays(int * arr, int length){
  * @param arr The array to be sorted.
  * @param length The number of elements in the array.
  */
-void selection_sort(int * arr, int length)
+void selection_sort_iterative(int * arr, int length)
 {
     // Traverse through all array elements
     for (int i = 0; i < length; i++)
@@ -73,43 +60,45 @@ void selection_sort(int * arr, int length)
     }
 }
 
+#ifdef SORT_DEMO
 int main()
 {
     // Test case 1: Regular unsorted array
     int unsorted_array1[5] = {64, 34, 25, 12, 22};
-    selection_sort(unsorted_array1, 5);
+    selection_sort_iterative(unsorted_array1, 5);
     printf("Sorted array 1: ");
-    printing_arrays(unsorted_array1, 5);
+    sort_print_array(unsorted_array1, 5);
 
     // Test case 2: Array with negative numbers
     int unsorted_array2[6] = {-3, 10, -1, 7, -20, 5};
-    selection_sort(unsorted_array2, 6);
+    selection_sort_iterative(unsorted_array2, 6);
     printf("Sorted array 2: ");
-    printing_arrays(unsorted_array2, 6);
+    sort_print_array(unsorted_array2, 6);
 
     // Test case 3: Already sorted array
     int sorted_array[5] = {1, 2, 3, 4, 5};
-    selection_sort(sorted_array, 5);
+    selection_sort_iterative(sorted_array, 5);
     printf("Sorted array 3: ");
-    printing_arrays(sorted_array, 5);
+    sort_print_array(sorted_array, 5);
 
     // Test case 4: Array with all elements the same
     int same_elements_array[4] = {5, 5, 5, 5};
-    selection_sort(same_elements_array, 4);
+    selection_sort_iterative(same_elements_array, 4);
     printf("Sorted array 4: ");
-    printing_arrays(same_elements_array, 4);
+    sort_print_array(same_elements_array, 4);
 
     // Test case 5: Array with a single element
     int single_element_array[1] = {42};
-    selection_sort(single_element_array, 1);
+    selection_sort_iterative(single_element_array, 1);
     printf("Sorted array 5: ");
-    printing_arrays(single_element_array, 1);
+    sort_print_array(single_element_array, 1);
 
     // Test case 6: Empty array
     int empty_array[0] = {};
-    selection_sort(empty_array, 0);
+    selection_sort_iterative(empty_array, 0);
     printf("Sorted array 6: ");
-    printing_arrays(empty_array, 0);
+    sort_print_array(empty_array, 0);
 
     return 0;
 }
+#endif /* SORT_DEMO */
@@ -37,7 +37,7 @@
  * @code
  * int arr[] = {5, 2, 8, 12, 3};
  * int n = sizeof(arr) / sizeof(arr[0]);
- * selection_sort_recursive(arr, 0, n);
+ * selection_sort_recursive(arr, n);
  * @endcode
  *
  * This implementation assumes that the array contains integers.
@@ -47,20 +47,7 @@
 #include <string.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param length The number of elements in the array.
- */
-void printf_array(int *arr, int length) {
-    for (int i = 0; i < length; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Recursive function to perform selection sort.
@@ -74,7 +61,7 @@ void printf_array(int *arr, int length) {
  * @param start The starting index of the unsorted part of the array.
  * @param length The number of elements in the array.
  */
-void selection_sort_recursive(int *arr, int start, int length) {
+static void selection_sort_from(int *arr, int start, int length) {
     // Base case: If the array has only one element or is empty, it is already sorted
     if (start >= length - 1) {
         return;
@@ -94,51 +81,63 @@ void selection_sort_recursive(int *arr, int start, int length) {
     arr[min_index] = temp;
 
     // Recursively call the selection sort function on the remaining unsorted part
-    selection_sort_recursive(arr, start + 1, length);
+    selection_sort_from(arr, start + 1, length);
+}
+
+/**
+ * @brief Sorts an array of n elements using recursive selection sort.
+ * 
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void selection_sort_recursive(int *arr, int n) {
+    selection_sort_from(arr, 0, n);
 }
 
+#ifdef SORT_DEMO
 int main() {
     // Test case 1: Regular unsorted array
     int unsorted_array1[5] = {5, 2, 8, 12, 3};
     int n1 = sizeof(unsorted_array1) / sizeof(unsorted_array1[0]);
-    selection_sort_recursive(unsorted_array1, 0, n1);
+    selection_sort_recursive(unsorted_array1, n1);
     printf("Sorted array 1: ");
-    printf_array(unsorted_array1, n1);
+    sort_print_array(unsorted_array1, n1);
 
     // Test case 2: Array with negative numbers
     int unsorted_array2[6] = {-3, 10, -1, 7, -20, 5};
     int n2 = sizeof(unsorted_array2) / sizeof(unsorted_array2[0]);
-    selection_sort_recursive(unsorted_array2, 0, n2);
+    selection_sort_recursive(unsorted_array2, n2);
     printf("Sorted array 2: ");
-    printf_array(unsorted_array2, n2);
+    sort_print_array(unsorted_array2, n2);
 
     // Test case 3: Already sorted array
     int sorted_array[5] = {1, 2, 3, 4, 5};
     int n3 = sizeof(sorted_array) / sizeof(sorted_array[0]);
-    selection_sort_recursive(sorted_array, 0, n3);
+    selection_sort_recursive(sorted_array, n3);
     printf("Sorted array 3: ");
-    printf_array(sorted_array, n3);
+    sort_print_array(sorted_array, n3);
 
     // Test case 4: Array with all elements the same
     int same_elements_array[4] = {5, 5, 5, 5};
     int n4 = sizeof(same_elements_array) / sizeof(same_elements_array[0]);
-    selection_sort_recursive(same_elements_array, 0, n4);
+    selection_sort_recursive(same_elements_array, n4);
     printf("Sorted array 4: ");
-    printf_array(same_elements_array, n4);
+    sort_print_array(same_elements_array, n4);
 
     // Test case 5: Array with a single element
     int single_element_array[1] = {42};
     int n5 = sizeof(single_element_array) / sizeof(single_element_array[0]);
-    selection_sort_recursive(single_element_array, 0, n5);
+    selection_sort_recursive(single_element_array, n5);
     printf("Sorted array 5: ");
-    printf_array(single_element_array, n5);
+    sort_print_array(single_element_array, n5);
 
     // Test case 6: Empty array
     int empty_array[0] = {};
     int n6 = sizeof(empty_array) / sizeof(empty_array[0]);
-    selection_sort_recursive(empty_array, 0, n6);
+    selection_sort_recursive(empty_array, n6);
     printf("Sorted array 6: ");
-    printf_array(empty_array, n6);
+    sort_print_array(empty_array, n6);
 
     return 0;
 }
+#endif /* SORT_DEMO */
@@ -33,20 +33,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array.
- * 
- * This function iterates through the array and prints each element.
- * 
- * @param arr The array to be printed.
- * @param n The number of elements in the array.
- */
-void printf_array(int *arr, int n) {
-    for (int i = 0; i < n; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Shifts elements of the array to the right by one position.
@@ -58,7 +45,7 @@ void printf_array(int *arr, int n) {
  * @param start The starting index of the shift.
  * @param end The ending index of the shift.
  */
-void shift_right_by_1(int *arr, int start, int end) {
+static void shift_right_by_1(int *arr, int start, int end) {
     for (int i = end; i > start; i--) {
         arr[i] = arr[i - 1];
     }
@@ -74,7 +61,7 @@ void shift_right_by_1(int *arr, int start, int end) {
  * @param arr The array to be sorted.
  * @param n The number of elements in the array.
  */
-void stable_selection_sort(int *arr, int n) {
+void selection_sort_stable(int *arr, int n) {
     for (int i = 0; i < n; i++) {
         int min_val_index = i;
         for (int j = i + 1; j < n; j++) {
@@ -93,48 +80,50 @@ void stable_selection_sort(int *arr, int n) {
     }
 }
 
+#ifdef SORT_DEMO
 int main() {
     // Test case 1: Regular unsorted array
     int unsorted_array1[5] = {64, 34, 25, 12, 22};
     int n1 = sizeof(unsorted_array1) / sizeof(unsorted_array1[0]);
-    stable_selection_sort(unsorted_array1, n1);
+    selection_sort_stable(unsorted_array1, n1);
     printf("Sorted array 1: ");
-    printf_array(unsorted_array1, n1);
+    sort_print_array(unsorted_array1, n1);
 
     // Test case 2: Array with negative numbers
     int unsorted_array2[6] = {-3, 10, -1, 7, -20, 5};
     int n2 = sizeof(unsorted_array2) / sizeof(unsorted_array2[0]);
-    stable_selection_sort(unsorted_array2, n2);
+    selection_sort_stable(unsorted_array2, n2);
     printf("Sorted array 2: ");
-    printf_array(unsorted_array2, n2);
+    sort_print_array(unsorted_array2, n2);
 
     // Test case 3: Already sorted array
     int sorted_array[5] = {1, 2, 3, 4, 5};
     int n3 = sizeof(sorted_array) / sizeof(sorted_array[0]);
-    stable_selection_sort(sorted_array, n3);
+    selection_sort_stable(sorted_array, n3);
     printf("Sorted array 3: ");
-    printf_array(sorted_array, n3);
+    sort_print_array(sorted_array, n3);
 
     // Test case 4: Array with all elements the same
     int same_elements_array[4] = {5, 5, 5, 5};
     int n4 = sizeof(same_elements_array) / sizeof(same_elements_array[0]);
-    stable_selection_sort(same_elements_array, n4);
+    selection_sort_stable(same_elements_array, n4);
     printf("Sorted array 4: ");
-    printf_array(same_elements_array, n4);
+    sort_print_array(same_elements_array, n4);
 
     // Test case 5: Array with a single element
     int single_element_array[1] = {42};
     int n5 = sizeof(single_element_array) / sizeof(single_element_array[0]);
-    stable_selection_sort(single_element_array, n5);
+    selection_sort_stable(single_element_array, n5);
     printf("Sorted array 5: ");
-    printf_array(single_element_array, n5);
+    sort_print_array(single_element_array, n5);
 
     // Test case 6: Empty array
     int empty_array[0] = {};
     int n6 = sizeof(empty_array) / sizeof(empty_array[0]);
-    stable_selection_sort(empty_array, n6);
+    selection_sort_stable(empty_array, n6);
     printf("Sorted array 6: ");
-    printf_array(empty_array, n6);
+    sort_print_array(empty_array, n6);
 
     return 0;
 }
+#endif /* SORT_DEMO */
@@ -29,18 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * @brief Prints the elements of an array of strings.
- * 
- * @param arr The array of strings to be printed.
- * @param n The number of elements in the array.
- */
-void printf_array_strings(char *arr[], int n) {
-    for (int i = 0; i < n; i++) {
-        printf("%s ", arr[i]);
-    }
-    printf("\n");
-}
+#include "sort.h"
 
 /**
  * @brief Performs selection sort on an array of strings.
@@ -66,6 +55,20 @@ void selection_sort_strings(char *arr[], int n) {
     }
 }
 
+#ifdef SORT_DEMO
+/**
+ * @brief Prints the elements of an array of strings.
+ * 
+ * @param arr The array of strings to be printed.
+ * @param n The number of elements in the array.
+ */
+static void printf_array_strings(char *arr[], int n) {
+    for (int i = 0; i < n; i++) {
+        printf("%s ", arr[i]);
+    }
+    printf("\n");
+}
+
 /**
  * @brief Main function to test the selection sort algorithm for strings.
  * 
@@ -83,3 +86,4 @@ int main() {
 
     return 0;
 }
+#endif /* SORT_DEMO */
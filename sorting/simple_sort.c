@@ -6,11 +6,11 @@
  * 
  * @details
  * This program implements the bubble sort algorithm in C. 
- * It defines a function bubbleSort that takes an array of integers and its length, 
+ * It defines a function simple_sort that takes an array of integers and its length, 
  * and sorts the array in ascending order using the bubble sort algorithm.
  * 
  * The main function initializes an array of integers, calculates its length, 
- * and calls the bubbleSort function to sort it. 
+ * and calls the simple_sort function to sort it. 
  * After sorting, it prints the sorted array to the standard output.
  * 
  * @section Performance
@@ -27,6 +27,8 @@
 
 #include <stdio.h>
 
+#include "sort.h"
+
 /**
  * @brief Sorts an array using bubble sort algorithm.
  * 
@@ -36,7 +38,7 @@
  * @param arr The array to be sorted.
  * @param n The number of elements in the array.
  */
-void bubbleSort(int arr[], int n) {
+void simple_sort(int arr[], int n) {
     int i, j, temp;
     for (i = 0; i < n-1; i++) {
         for (j = 0; j < n-i-1; j++) {
@@ -49,6 +51,7 @@ void bubbleSort(int arr[], int n) {
     }
 }
 
+#ifdef SORT_DEMO
 /**
  * @brief Main function to test the bubble sort algorithm.
  * 
@@ -60,12 +63,14 @@ int main() {
     int arr[] = {64, 34, 25, 12, 22, 11, 90};
     int n = sizeof(arr)/sizeof(arr[0]);
     
-    bubbleSort(arr, n);
+    simple_sort(arr, n);
     
     printf("Sorted array: \n");
     for (int i = 0; i < n; i++) {
         printf("%d ", arr[i]);
     }
+    printf("\n");
     
     return 0;
 }
+#endif /* SORT_DEMO */
@@ -0,0 +1,130 @@
+/**
+ * @file sort.c
+ * @brief Dispatching entry point of the sorting library.
+ *
+ * @details
+ * sort_ints() looks the requested algorithm up in a table of the integer sorts exported by
+ * the other files in this directory and runs it. Because every entry has the same signature,
+ * the table is also a convenient way to run all variants side by side in one process.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "sort.h"
+
+/**
+ * @brief One row of the dispatch table.
+ */
+typedef struct {
+    const char *name;              /**< Printable name of the algorithm. */
+    void (*sort)(int *arr, int n); /**< Function implementing it. */
+} sort_entry_t;
+
+/* Indexed by sort_algorithm_t, so keep it in the same order as the enum. */
+static const sort_entry_t sort_table[SORT_ALGORITHM_COUNT] = {
+    [SORT_BUBBLE]              = {"bubble", bubble_sort_simple},
+    [SORT_BUBBLE_RECURSIVE]    = {"bubble_recursive", bubble_sort_recursive},
+    [SORT_SIMPLE]              = {"simple", simple_sort},
+    [SORT_INSERTION]           = {"insertion", insertion_sort_iterative},
+    [SORT_INSERTION_RECURSIVE] = {"insertion_recursive", insertion_sort_recursive},
+    [SORT_SELECTION]           = {"selection", selection_sort_iterative},
+    [SORT_SELECTION_RECURSIVE] = {"selection_recursive", selection_sort_recursive},
+    [SORT_SELECTION_STABLE]    = {"selection_stable", selection_sort_stable},
+    [SORT_MERGE]               = {"merge", merge_sort_simple},
+    [SORT_QUICK]               = {"quick", quick_sort_simple},
+    [SORT_QUICK_THREE_WAY]     = {"quick_three_way", quick_sort_three_way},
+    [SORT_QUICK_DUAL_PIVOT]    = {"quick_dual_pivot", quick_sort_dual_pivot},
+    [SORT_HEAP]                = {"heap", heap_sort_simple},
+    [SORT_HEAP_RECURSIVE]      = {"heap_recursive", heap_sort_recursive},
+    [SORT_COUNTING]            = {"counting", counting_sort_simple},
+    [SORT_COUNTING_RECURSIVE]  = {"counting_recursive", counting_sort_recursive},
+    [SORT_RADIX]               = {"radix", radix_sort_simple},
+    [SORT_INTRO]               = {"intro", intro_sort},
+    [SORT_PDQ]                 = {"pdq", pdq_sort},
+    [SORT_MERGE_PARALLEL]      = {"merge_parallel", merge_sort_parallel},
+    [SORT_MERGE_BUFFERED]      = {"merge_buffered", merge_sort_buffered},
+    [SORT_TIM]                 = {"tim", tim_sort},
+    [SORT_RADIX_LSD]           = {"radix_lsd", radix_sort_lsd},
+    [SORT_RADIX_PARALLEL]      = {"radix_parallel", radix_sort_parallel},
+    [SORT_COUNTING_RANGE]      = {"counting_range", counting_sort_range},
+    [SORT_QUICK_VECTORIZED]    = {"quick_vectorized", quick_sort_vectorized},
+    [SORT_QUICK_PARALLEL]      = {"quick_parallel", quick_sort_parallel},
+    [SORT_HEAP_BOTTOM_UP]      = {"heap_bottom_up", heap_sort_bottom_up},
+};
+
+int sort_ints(int *arr, int n, sort_algorithm_t algorithm) {
+    if ((unsigned)algorithm >= SORT_ALGORITHM_COUNT || n < 0 || (arr == NULL && n > 0)) {
+        return -1;
+    }
+    // Zero or one element is already sorted; several algorithms read arr[0] unconditionally
+    if (n < 2) {
+        return 0;
+    }
+    sort_table[algorithm].sort(arr, n);
+    return 0;
+}
+
+const char *sort_algorithm_name(sort_algorithm_t algorithm) {
+    if ((unsigned)algorithm >= SORT_ALGORITHM_COUNT) {
+        return "unknown";
+    }
+    return sort_table[algorithm].name;
+}
+
+void sort_print_array(const int *arr, int n) {
+    for (int i = 0; i < n; i++) {
+        printf("%d ", arr[i]);
+    }
+    printf("\n");
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Driver code that runs every algorithm on the same inputs.
+ *
+ * Each algorithm sorts a copy of a pseudo-random array and the result is checked to be
+ * in non-decreasing order and to contain the same sum as the input.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    enum { N = 500 };
+    int input[N];
+    int work[N];
+
+    srand(42);
+    for (int i = 0; i < N; i++) {
+        input[i] = rand() % 1000; // Non-negative so that counting and radix sort apply
+    }
+
+    for (int a = 0; a < SORT_ALGORITHM_COUNT; a++) {
+        long long sum_before = 0, sum_after = 0;
+        for (int i = 0; i < N; i++) {
+            work[i] = input[i];
+            sum_before += input[i];
+        }
+        assert(sort_ints(work, N, (sort_algorithm_t)a) == 0);
+        for (int i = 0; i < N; i++) {
+            sum_after += work[i];
+            if (i > 0) {
+                assert(work[i - 1] <= work[i]);
+            }
+        }
+        assert(sum_before == sum_after);
+        printf("%-20s ok\n", sort_algorithm_name((sort_algorithm_t)a));
+    }
+
+    // Invalid arguments are rejected, trivial inputs accepted
+    assert(sort_ints(work, N, SORT_ALGORITHM_COUNT) == -1);
+    assert(sort_ints(NULL, 3, SORT_QUICK) == -1);
+    assert(sort_ints(NULL, 0, SORT_QUICK) == 0);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,260 @@
+/**
+ * @file sort.h
+ * @brief Public interface of the sorting library (libsort).
+ *
+ * @details
+ * Every file in this directory implements one sorting algorithm. Built together they form
+ * libsort, which can be linked as a static (`libsort.a`) or shared (`libsort.so`) library.
+ * Each algorithm is exposed under a function named after its source file, and all of the
+ * integer sorts share the signature `void name(int *arr, int n)`, so they can be swapped
+ * for one another or selected at run time through sort_ints().
+ *
+ * The driver code that used to live in each file's `main()` is still there, compiled only
+ * when `SORT_DEMO` is defined (see `make demos` / `make test`).
+ *
+ * The parallel sorts run on a shared thread pool with one thread per online CPU; set the
+ * SORT_THREADS environment variable before the first parallel sort to change that.
+ *
+ * @section Example Usage
+ * @code
+ * #include "sort.h"
+ *
+ * int arr[] = {5, 2, 8, 12, 3};
+ * sort_ints(arr, 5, SORT_QUICK);
+ * @endcode
+ */
+
+#ifndef SORT_H
+#define SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Algorithms selectable through sort_ints().
+ */
+typedef enum {
+    SORT_BUBBLE,              /**< bubble_sort_simple() */
+    SORT_BUBBLE_RECURSIVE,    /**< bubble_sort_recursive() */
+    SORT_SIMPLE,              /**< simple_sort() */
+    SORT_INSERTION,           /**< insertion_sort_iterative() */
+    SORT_INSERTION_RECURSIVE, /**< insertion_sort_recursive() */
+    SORT_SELECTION,           /**< selection_sort_iterative() */
+    SORT_SELECTION_RECURSIVE, /**< selection_sort_recursive() */
+    SORT_SELECTION_STABLE,    /**< selection_sort_stable() */
+    SORT_MERGE,               /**< merge_sort_simple() */
+    SORT_QUICK,               /**< quick_sort_simple() */
+    SORT_QUICK_THREE_WAY,     /**< quick_sort_three_way() */
+    SORT_QUICK_DUAL_PIVOT,    /**< quick_sort_dual_pivot() */
+    SORT_HEAP,                /**< heap_sort_simple() */
+    SORT_HEAP_RECURSIVE,      /**< heap_sort_recursive() */
+    SORT_COUNTING,            /**< counting_sort_simple() (non-negative keys only) */
+    SORT_COUNTING_RECURSIVE,  /**< counting_sort_recursive() (non-negative keys only) */
+    SORT_RADIX,               /**< radix_sort_simple() (non-negative keys only) */
+    SORT_INTRO,               /**< intro_sort() */
+    SORT_PDQ,                 /**< pdq_sort() */
+    SORT_MERGE_PARALLEL,      /**< merge_sort_parallel() */
+    SORT_MERGE_BUFFERED,      /**< merge_sort_buffered() */
+    SORT_TIM,                 /**< tim_sort() */
+    SORT_RADIX_LSD,           /**< radix_sort_lsd() */
+    SORT_RADIX_PARALLEL,      /**< radix_sort_parallel() */
+    SORT_COUNTING_RANGE,      /**< counting_sort_range() */
+    SORT_QUICK_VECTORIZED,    /**< quick_sort_vectorized() */
+    SORT_QUICK_PARALLEL,      /**< quick_sort_parallel() */
+    SORT_HEAP_BOTTOM_UP,      /**< heap_sort_bottom_up() */
+    SORT_ALGORITHM_COUNT      /**< Number of algorithms, not an algorithm itself. */
+} sort_algorithm_t;
+
+/**
+ * @brief Sorts an array of integers in ascending order with the chosen algorithm.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param algorithm The algorithm to use.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int sort_ints(int *arr, int n, sort_algorithm_t algorithm);
+
+/**
+ * @brief Returns a printable name for an algorithm.
+ *
+ * @param algorithm The algorithm.
+ * @return The name, or "unknown" if algorithm is out of range.
+ */
+const char *sort_algorithm_name(sort_algorithm_t algorithm);
+
+/**
+ * @brief Prints the elements of an array on one line.
+ *
+ * @param arr The array to be printed.
+ * @param n The number of elements in the array.
+ */
+void sort_print_array(const int *arr, int n);
+
+/* Individual algorithms, one per source file. */
+void bubble_sort_simple(int *arr, int n);
+void bubble_sort_recursive(int *arr, int n);
+void simple_sort(int *arr, int n);
+void insertion_sort_iterative(int *arr, int n);
+void insertion_sort_recursive(int *arr, int n);
+void selection_sort_iterative(int *arr, int n);
+void selection_sort_recursive(int *arr, int n);
+void selection_sort_stable(int *arr, int n);
+void selection_sort_strings(char *arr[], int n);
+void merge_sort_simple(int *arr, int n);
+void quick_sort_simple(int *arr, int n);
+void quick_sort_three_way(int *arr, int n);
+void quick_sort_dual_pivot(int *arr, int n);
+void heap_sort_simple(int *arr, int n);
+void heap_sort_recursive(int *arr, int n);
+void counting_sort_simple(int *arr, int n);
+void counting_sort_recursive(int *arr, int n);
+void radix_sort_simple(int *arr, int n);
+void intro_sort(int *arr, int n);
+void pdq_sort(int *arr, int n);
+void merge_sort_parallel(int *arr, int n);
+void merge_sort_buffered(int *arr, int n);
+void tim_sort(int *arr, int n);
+void radix_sort_lsd(int *arr, int n);
+void radix_sort_parallel(int *arr, int n);
+void counting_sort_range(int *arr, int n);
+void quick_sort_vectorized(int *arr, int n);
+void quick_sort_parallel(int *arr, int n);
+void heap_sort_bottom_up(int *arr, int n);
+
+/**
+ * @brief Merge sort that uses the caller's scratch buffer and does not allocate.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param scratch A buffer of at least n elements; its contents are overwritten.
+ */
+void merge_sort_scratch(int *arr, int n, int *scratch);
+
+/**
+ * @brief LSD radix sort with a chosen digit width.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param digit_bits Bits per digit, from 1 to 16 (8, 11 and 16 are the useful ones), or 0 to
+ *                   choose based on n.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int radix_sort_lsd_bits(int *arr, int n, int digit_bits);
+
+/**
+ * @brief Counting sort that refuses key ranges wider than max_range.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ * @param max_range The largest acceptable max - min + 1.
+ * @return 0 on success, -1 if the arguments are invalid, the key range exceeds max_range or
+ *         memory cannot be allocated (the array is then left unchanged).
+ */
+int counting_sort_range_max(int *arr, int n, size_t max_range);
+
+/*
+ * Radix sorts for other key types (radix_sort_keys.c). Floating point values are ordered
+ * by IEEE totalOrder: -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN.
+ */
+void radix_sort_u32(uint32_t *arr, int n);
+void radix_sort_i32(int32_t *arr, int n);
+void radix_sort_u64(uint64_t *arr, int n);
+void radix_sort_i64(int64_t *arr, int n);
+void radix_sort_float(float *arr, int n);
+void radix_sort_double(double *arr, int n);
+
+/*
+ * Type-generic sorts (sort_generic.c). sort_generic() has the interface of qsort(); the
+ * others are specializations generated from sort_template.h, which can also be used to
+ * generate a sort for any other element type.
+ */
+void sort_generic(void *base, size_t nmemb, size_t size,
+                  int (*compar)(const void *, const void *));
+void sort_i32(int32_t *arr, size_t n);
+void sort_i64(int64_t *arr, size_t n);
+void sort_f32(float *arr, size_t n);
+void sort_f64(double *arr, size_t n);
+void sort_ptr(void **arr, size_t n);
+
+/**
+ * @brief Sorts an array with bottom-up heap sort on a heap with 2, 4 or 8 children per node.
+ *
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int heap_sort_dary(int *arr, int n, int arity);
+
+/*
+ * Selection (nth_element.c): nth_element() puts the element that belongs at position k there,
+ * with no larger element before it and no smaller one after; partial_sort() puts the k
+ * smallest elements, sorted, in arr[0..k). Both return 0 on success, -1 if the arguments are
+ * invalid.
+ */
+int nth_element(int *arr, int n, int k);
+int partial_sort(int *arr, int n, int k);
+
+/**
+ * @brief Engines available to sort_kv() and argsort().
+ */
+typedef enum {
+    SORT_KV_QUICK,       /**< Introsort; not stable. */
+    SORT_KV_MERGE,       /**< Merge sort; stable. */
+    SORT_KV_HEAP,        /**< Heap sort; not stable. */
+    SORT_KV_RADIX,       /**< LSD radix sort; stable. */
+    SORT_KV_ENGINE_COUNT /**< Number of engines, not an engine itself. */
+} sort_kv_engine_t;
+
+/**
+ * @brief Sorts keys in ascending order and applies the same reordering to values.
+ *
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int sort_kv(int *keys, int *values, int n, sort_kv_engine_t engine);
+
+/**
+ * @brief Fills out_idx with the permutation that sorts keys, leaving keys unchanged.
+ *
+ * @return 0 on success, -1 if the arguments are invalid or memory cannot be allocated.
+ */
+int argsort(const int *keys, int n, int *out_idx, sort_kv_engine_t engine);
+
+/**
+ * @brief Reorders n values of the given size in place so that the new values[i] is the old
+ *        values[idx[i]], following the cycles of the permutation.
+ *
+ * @return 0 on success, -1 if the arguments are invalid, idx is not a permutation of 0..n-1
+ *         or memory cannot be allocated.
+ */
+int sort_permute(void *values, size_t size, const int *idx, int n);
+
+/** Largest array sort_network() sorts with a network rather than handing to intro_sort(). */
+#define SORT_NETWORK_MAX 64
+
+/*
+ * Small-array sorting networks (sort_network.c), using AVX-512 or AVX2 when the CPU has them
+ * and insertion sort otherwise. sort_network_cutoff() is the base case size recursive sorts
+ * should use with it; sort_network_isa() names the kernel ("avx512", "avx2" or "scalar").
+ */
+void sort_network(int *arr, int n);
+int sort_network_cutoff(void);
+const char *sort_network_isa(void);
+
+/**
+ * @brief Partition kernels available to quick_sort_engine().
+ */
+typedef enum {
+    QUICK_SORT_AUTO,       /**< The fastest kernel the CPU supports. */
+    QUICK_SORT_SCALAR,     /**< Two-pointer partition, one element at a time. */
+    QUICK_SORT_VECTORIZED, /**< AVX-512 or AVX2 partition; scalar on other CPUs. */
+    QUICK_SORT_BRANCHLESS, /**< Block partition without data-dependent branches. */
+    QUICK_SORT_MODE_COUNT  /**< Number of modes, not a mode itself. */
+} quick_sort_mode_t;
+
+/**
+ * @brief Sorts an array with quick sort using the chosen partition kernel.
+ *
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int quick_sort_engine(int *arr, int n, quick_sort_mode_t mode);
+
+#endif /* SORT_H */
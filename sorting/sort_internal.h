@@ -0,0 +1,329 @@
+/**
+ * @file sort_internal.h
+ * @brief Helpers shared between the libsort source files.
+ *
+ * @details
+ * This header is not part of the public interface. It holds the small utilities that
+ * every algorithm file used to define for itself (swap and friends), and the macros that
+ * generate the merge and radix engines shared by the int sorts and sort_kv().
+ */
+
+#ifndef SORT_INTERNAL_H
+#define SORT_INTERNAL_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sort_template.h"
+
+/**
+ * @brief Swaps two integers.
+ *
+ * @param a Pointer to the first element.
+ * @param b Pointer to the second element.
+ */
+static inline void sort_swap(int *a, int *b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * @brief Three-way partition of arr[low..high] around arr[low] (quick_sort_three_way.c).
+ *
+ * On return arr[low..*lt-1] < pivot, arr[*lt..*gt] == pivot and arr[*gt+1..high] > pivot.
+ *
+ * @param arr The array to be partitioned.
+ * @param low The starting index of the segment.
+ * @param high The ending index of the segment.
+ * @param lt Receives the first index of the 'equal to pivot' segment.
+ * @param gt Receives the last index of the 'equal to pivot' segment.
+ */
+void sort_three_way_partition(int *arr, int low, int high, int *lt, int *gt);
+
+/** Elements classified per block by sort_block_partition(); offsets must fit an unsigned char. */
+#define SORT_BLOCK_SIZE 64
+
+/**
+ * @brief Swaps the elements named by two offset buffers (sort_block_partition()).
+ *
+ * When the buffers have different lengths a cyclic permutation is used instead of
+ * pairwise swaps, which saves one move per element.
+ *
+ * @param first Base of the left offsets.
+ * @param last Base of the right offsets (offsets are subtracted).
+ * @param offsets_l Offsets of misplaced elements on the left.
+ * @param offsets_r Offsets of misplaced elements on the right.
+ * @param num Number of pairs to exchange.
+ * @param use_swaps Nonzero to use plain swaps.
+ */
+static inline void sort_block_swap_offsets(int *first, int *last,
+                                           const unsigned char *offsets_l,
+                                           const unsigned char *offsets_r, int num,
+                                           int use_swaps) {
+    if (use_swaps) {
+        for (int i = 0; i < num; i++)
+            sort_swap(first + offsets_l[i], last - offsets_r[i]);
+    } else if (num > 0) {
+        int *l = first + offsets_l[0];
+        int *r = last - offsets_r[0];
+        int tmp = *l;
+        *l = *r;
+        for (int i = 1; i < num; i++) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+        *r = tmp;
+    }
+}
+
+/**
+ * @brief Branchless block partition of [first, last) as in BlockQuicksort (pdq_sort.c,
+ *        quick_sort_engine.c).
+ *
+ * Moves the elements less than pivot to the front. Blocks of up to SORT_BLOCK_SIZE elements
+ * from each end are scanned into lists of misplaced offsets, where the comparison only
+ * decides whether a list grows; pairs from the two lists are then exchanged, and a side
+ * whose list runs out scans its next block. The block sizes shrink to split whatever is
+ * left, so no separate pass is needed for the remainder.
+ *
+ * @param first Pointer to the first element.
+ * @param last Pointer one past the last element.
+ * @param pivot The value to partition around.
+ * @return Pointer to the first element that is not less than pivot.
+ */
+static inline int *sort_block_partition(int *first, int *last, int pivot) {
+    unsigned char offsets_l[SORT_BLOCK_SIZE];
+    unsigned char offsets_r[SORT_BLOCK_SIZE];
+    int *offsets_l_base = first;
+    int *offsets_r_base = last;
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (first < last) {
+        // Decide how many unknown elements each side classifies in this round
+        int num_unknown = (int)(last - first);
+        int left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+        int right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+        if (left_split > SORT_BLOCK_SIZE)
+            left_split = SORT_BLOCK_SIZE;
+        if (right_split > SORT_BLOCK_SIZE)
+            right_split = SORT_BLOCK_SIZE;
+
+        // Record the offsets of misplaced elements without branching on the data
+        for (int i = 0; i < left_split; i++) {
+            offsets_l[num_l] = (unsigned char)i;
+            num_l += !(*first < pivot);
+            first++;
+        }
+        for (int i = 0; i < right_split; i++) {
+            offsets_r[num_r] = (unsigned char)(i + 1);
+            num_r += *--last < pivot;
+        }
+
+        // Exchange as many misplaced pairs as possible
+        int num = num_l < num_r ? num_l : num_r;
+        sort_block_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                                offsets_r + start_r, num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+
+        if (num_l == 0) {
+            start_l = 0;
+            offsets_l_base = first;
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            offsets_r_base = last;
+        }
+    }
+
+    // At most one side has leftovers; move them next to the boundary
+    if (num_l) {
+        while (num_l--)
+            sort_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+        first = last;
+    }
+    if (num_r) {
+        while (num_r--) {
+            sort_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+            first++;
+        }
+    }
+    return first;
+}
+
+/* Values returned by sort_simd_level() */
+#define SORT_SIMD_NONE 0
+#define SORT_SIMD_AVX2 1
+#define SORT_SIMD_AVX512 2 /* AVX-512F, which implies AVX2 */
+
+/**
+ * @brief Returns the widest SIMD instruction set the CPU supports (sort_network.c).
+ */
+int sort_simd_level(void);
+
+/**
+ * @brief Defines name_sift_up() and name_sift_bottom_up() for a d-ary heap of ints in which
+ *        above(a, b) is nonzero if a belongs above b: `>` gives a max-heap, `<` a min-heap
+ *        (heap_sort_bottom_up.c, top_k.c).
+ *
+ * name_sift_up(heap, root, hole, x, d) moves x up from the free slot hole, no higher than
+ * root. name_sift_bottom_up(heap, n, root, x, d) places x in the heap of n elements rooted at
+ * root, whose root slot is free, with Floyd's bottom-up sift: the free slot first descends to
+ * a leaf along the children that belong highest, then x rises from there to its place, which
+ * saves comparisons when x belongs near the bottom. Passing d as a constant lets the compiler
+ * turn the index arithmetic into shifts.
+ */
+#define SORT_DEFINE_INT_HEAP_(name, above)                                                     \
+    static inline void name##_sift_up(int *heap, int root, int hole, int x, const int d) {     \
+        while (hole > root) {                                                                  \
+            int parent = (hole - 1) / d;                                                       \
+            if (!above(x, heap[parent]))                                                       \
+                break;                                                                         \
+            heap[hole] = heap[parent];                                                         \
+            hole = parent;                                                                     \
+        }                                                                                      \
+        heap[hole] = x;                                                                        \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_sift_bottom_up(int *heap, int n, int root, int x, const int d) { \
+        int hole = root;                                                                       \
+        /* Last node with a child. Comparing hole against it, rather than d * hole + 1        \
+           against n, keeps the child indexes from overflowing when n is close to INT_MAX */   \
+        const int last_parent = n >= 2 ? (n - 2) / d : -1;                                     \
+                                                                                               \
+        while (hole <= last_parent) {                                                          \
+            int first = d * hole + 1;                                                          \
+            int last = first < n - d ? first + d : n;                                          \
+            int best = first;                                                                  \
+            for (int c = first + 1; c < last; c++) {                                           \
+                if (above(heap[c], heap[best]))                                                \
+                    best = c;                                                                  \
+            }                                                                                  \
+            heap[hole] = heap[best];                                                           \
+            hole = best;                                                                       \
+        }                                                                                      \
+        name##_sift_up(heap, root, hole, x, d);                                                \
+    }
+
+/*
+ * Engine generators. Like SORT_DEFINE_KV() they sort keys and carry a parallel value array
+ * when carry is 1; with carry 0 they sort the keys alone and values may be NULL.
+ */
+
+/**
+ * @brief Defines name_sort_into(src_keys, src_values, dst_keys, dst_values, n), a stable
+ *        merge sort of n elements into dst that uses src as the other buffer
+ *        (merge_sort_buffered.c).
+ *
+ * On entry src and dst must hold the same elements. The recursion alternates the roles of
+ * the two buffers between levels, so apart from the initial copy that sets this up every
+ * element is moved once per level. Ranges of at most threshold elements are finished with
+ * insertion sort.
+ */
+#define SORT_DEFINE_MERGE_(name, key_type, value_type, less, carry, threshold)                 \
+    SORT_DEFINE_INSERTION_(name, key_type, value_type, less, carry)                            \
+                                                                                               \
+    /* Merges the sorted runs [0, mid) and [mid, n) of src into dst */                         \
+    static void name##_merge_into(const key_type *src_keys, const value_type *src_values,      \
+                                  size_t mid, size_t n, key_type *dst_keys,                    \
+                                  value_type *dst_values) {                                    \
+        size_t i = 0, j = mid, k = 0;                                                          \
+        while (i < mid && j < n) {                                                             \
+            /* Take from the left run on ties to keep the sort stable */                       \
+            size_t from = less(src_keys[j], src_keys[i]) ? j++ : i++;                          \
+            dst_keys[k] = src_keys[from];                                                      \
+            if (carry)                                                                         \
+                dst_values[k] = src_values[from];                                              \
+            k++;                                                                               \
+        }                                                                                      \
+        memcpy(dst_keys + k, src_keys + i, (mid - i) * sizeof(key_type));                      \
+        memcpy(dst_keys + k + mid - i, src_keys + j, (n - j) * sizeof(key_type));              \
+        if (carry) {                                                                           \
+            memcpy(dst_values + k, src_values + i, (mid - i) * sizeof(value_type));            \
+            memcpy(dst_values + k + mid - i, src_values + j, (n - j) * sizeof(value_type));    \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    static void name##_sort_into(key_type *src_keys, value_type *src_values,                   \
+                                 key_type *dst_keys, value_type *dst_values, size_t n) {       \
+        if (n <= (threshold)) {                                                                \
+            name##_insertion(dst_keys, dst_values, n);                                         \
+            return;                                                                            \
+        }                                                                                      \
+        size_t mid = n / 2;                                                                    \
+        name##_sort_into(dst_keys, dst_values, src_keys, src_values, mid);                     \
+        name##_sort_into(dst_keys + mid, SORT_VALUES_AT_(carry, dst_values, mid),              \
+                         src_keys + mid, SORT_VALUES_AT_(carry, src_values, mid), n - mid);    \
+        name##_merge_into(src_keys, src_values, mid, n, dst_keys, dst_values);                 \
+    }
+
+/**
+ * @brief Defines name(keys, values, key_buf, value_buf, n, digit_bits, count), a stable LSD
+ *        radix sort of n >= 1 elements with digits of digit_bits (1 to 16) bits
+ *        (radix_sort_lsd.c).
+ *
+ * bits_of(key) maps a key to an unsigned integer of the same width whose order is the order
+ * of the keys. count must hold ceil(bits / digit_bits) << digit_bits zeroed counters for
+ * bits-wide keys; the histograms of every digit position are gathered in one read of the
+ * keys. Passes in which every key has the same digit would only copy the data and are
+ * skipped, and each remaining pass scatters from one buffer into the other. The result ends
+ * up in keys and values.
+ */
+#define SORT_DEFINE_RADIX_LSD_(name, key_type, value_type, bits_of, carry)                     \
+    static void name(key_type *keys, value_type *values, key_type *key_buf,                    \
+                     value_type *value_buf, size_t n, int digit_bits, unsigned *count) {       \
+        const int passes = ((int)sizeof(key_type) * 8 + digit_bits - 1) / digit_bits;          \
+        const size_t radix = (size_t)1 << digit_bits;                                          \
+        const size_t mask = radix - 1;                                                         \
+                                                                                               \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            for (int p = 0; p < passes; p++) {                                                 \
+                count[p * radix + ((bits_of(keys[i]) >> (p * digit_bits)) & mask)]++;          \
+            }                                                                                  \
+        }                                                                                      \
+                                                                                               \
+        key_type *src_keys = keys, *dst_keys = key_buf;                                        \
+        value_type *src_values = values, *dst_values = value_buf;                              \
+        for (int p = 0; p < passes; p++) {                                                     \
+            unsigned *c = count + p * radix;                                                   \
+            int shift = p * digit_bits;                                                        \
+            if (c[(bits_of(src_keys[0]) >> shift) & mask] == n) {                              \
+                continue;                                                                      \
+            }                                                                                  \
+                                                                                               \
+            /* Turn the counts into starting offsets */                                        \
+            unsigned sum = 0;                                                                  \
+            for (size_t d = 0; d < radix; d++) {                                               \
+                unsigned temp = c[d];                                                          \
+                c[d] = sum;                                                                    \
+                sum += temp;                                                                   \
+            }                                                                                  \
+            for (size_t i = 0; i < n; i++) {                                                   \
+                unsigned pos = c[(bits_of(src_keys[i]) >> shift) & mask]++;                    \
+                dst_keys[pos] = src_keys[i];                                                   \
+                if (carry)                                                                     \
+                    dst_values[pos] = src_values[i];                                           \
+            }                                                                                  \
+                                                                                               \
+            key_type *temp_keys = src_keys;                                                    \
+            src_keys = dst_keys;                                                               \
+            dst_keys = temp_keys;                                                              \
+            value_type *temp_values = src_values;                                              \
+            src_values = dst_values;                                                           \
+            dst_values = temp_values;                                                          \
+        }                                                                                      \
+                                                                                               \
+        if (src_keys != keys) {                                                                \
+            memcpy(keys, src_keys, n * sizeof(key_type));                                      \
+            if (carry)                                                                         \
+                memcpy(values, src_values, n * sizeof(value_type));                            \
+        }                                                                                      \
+    }
+
+#endif /* SORT_INTERNAL_H */
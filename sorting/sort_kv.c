@@ -0,0 +1,326 @@
+/**
+ * @file sort_kv.c
+ * @brief Key-value sorting and argsort on the quick, merge, heap and radix engines.
+ *
+ * @details
+ * The other sorts in this directory reorder bare ints. Here every engine sorts a key array
+ * and carries a parallel value array along with it (struct-of-arrays, so the keys stay
+ * densely packed for the comparisons and the values are only touched when an element moves).
+ * The engines are not separate implementations: they are generated from the same macros as
+ * the int and typed sorts (SORT_DEFINE_KV() in sort_template.h, SORT_DEFINE_MERGE_() and
+ * SORT_DEFINE_RADIX_LSD_() in sort_internal.h), with the value moves switched on:
+ * - **SORT_KV_QUICK**: introsort (median-of-three Hoare partition, heap sort fallback,
+ *   insertion sort for small segments). Not stable.
+ * - **SORT_KV_MERGE**: merge sort that ping-pongs between the arrays and one pair of
+ *   auxiliary arrays, as in merge_sort_buffered.c. Stable.
+ * - **SORT_KV_HEAP**: heap sort, in place. Not stable.
+ * - **SORT_KV_RADIX**: 8-bit LSD radix sort with one histogram pass and trivial passes
+ *   skipped, as in radix_sort_lsd.c. Stable, and the fastest for large inputs.
+ *
+ * On top of that:
+ * - sort_kv() sorts keys and int values (row IDs, indices) together.
+ * - argsort() returns the permutation that sorts the keys, leaving them unchanged. With a
+ *   stable engine, equal keys keep their original order.
+ * - sort_permute() applies such a permutation, in place, to values of any size. Sorting
+ *   records by an int key is then argsort() followed by sort_permute(), which copies every
+ *   record about once (once plus one copy per cycle of the permutation) no matter how many
+ *   steps the sort itself takes.
+ *
+ * If an auxiliary buffer cannot be allocated, the merge and radix engines fall back to heap
+ * sort and are then not stable.
+ *
+ * @section Performance
+ * - Quick, merge and heap: O(n log n) time. Radix: O(n) time.
+ * - Space Complexity: O(log n) for quick and heap, O(n) for merge and radix.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+/** Merge sort ranges of this size or smaller are finished with insertion sort. */
+#define SORT_KV_THRESHOLD 16
+
+static inline uint32_t kv_bits(int key) {
+    return (uint32_t)key ^ 0x80000000u;
+}
+
+SORT_DEFINE_KV(static, kv_quick, int, int, SORT_LESS)
+SORT_DEFINE_MERGE_(kv_merge, int, int, SORT_LESS, 1, SORT_KV_THRESHOLD)
+SORT_DEFINE_RADIX_LSD_(kv_radix_lsd, int, int, kv_bits, 1)
+
+static void kv_merge(int *keys, int *values, int n) {
+    if (n <= SORT_KV_THRESHOLD) {
+        kv_merge_insertion(keys, values, n);
+        return;
+    }
+
+    int *aux = malloc(2 * (size_t)n * sizeof(int));
+    if (aux == NULL) {
+        kv_quick_heap_sort(keys, values, n);
+        return;
+    }
+    memcpy(aux, keys, n * sizeof(int));
+    memcpy(aux + n, values, n * sizeof(int));
+    kv_merge_sort_into(aux, aux + n, keys, values, n);
+    free(aux);
+}
+
+static void kv_radix(int *keys, int *values, int n) {
+    if (n <= SORT_KV_THRESHOLD) {
+        kv_merge_insertion(keys, values, n);
+        return;
+    }
+
+    int *aux = malloc(2 * (size_t)n * sizeof(int));
+    if (aux == NULL) {
+        kv_quick_heap_sort(keys, values, n);
+        return;
+    }
+    unsigned count[4 * 256] = {0};
+    kv_radix_lsd(keys, values, aux, aux + n, n, 8, count);
+    free(aux);
+}
+
+/**
+ * @brief Sorts keys in ascending order and applies the same reordering to values.
+ *
+ * @param keys The keys to be sorted.
+ * @param values The values, one per key; they are not compared.
+ * @param n The number of pairs.
+ * @param engine The algorithm to use.
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int sort_kv(int *keys, int *values, int n, sort_kv_engine_t engine) {
+    if (n < 0 || (n > 0 && (keys == NULL || values == NULL))) {
+        return -1;
+    }
+
+    switch (engine) {
+    case SORT_KV_QUICK:
+        kv_quick(keys, values, n);
+        return 0;
+    case SORT_KV_MERGE:
+        kv_merge(keys, values, n);
+        return 0;
+    case SORT_KV_HEAP:
+        kv_quick_heap_sort(keys, values, n);
+        return 0;
+    case SORT_KV_RADIX:
+        kv_radix(keys, values, n);
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Computes the permutation that sorts keys, without modifying them.
+ *
+ * @param keys The keys.
+ * @param n The number of keys.
+ * @param out_idx Receives n indices such that keys[out_idx[0]] <= keys[out_idx[1]] <= ...
+ * @param engine The algorithm to use.
+ * @return 0 on success, -1 if the arguments are invalid or memory cannot be allocated.
+ */
+int argsort(const int *keys, int n, int *out_idx, sort_kv_engine_t engine) {
+    if (n < 0 || (n > 0 && (keys == NULL || out_idx == NULL)) ||
+        (unsigned)engine >= SORT_KV_ENGINE_COUNT) {
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    int *copy = malloc(n * sizeof(int));
+    if (copy == NULL) {
+        return -1;
+    }
+    memcpy(copy, keys, n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        out_idx[i] = i;
+    }
+    sort_kv(copy, out_idx, n, engine);
+    free(copy);
+    return 0;
+}
+
+/**
+ * @brief Reorders values so that the new values[i] is the old values[idx[i]].
+ *
+ * The permutation is applied in place, one cycle at a time: the first value of a cycle is
+ * saved, every other value is copied straight into its final slot, and the saved value fills
+ * the last one. Each value is copied once, plus one extra copy per cycle, and the only
+ * memory needed is one bit per value and room for one value.
+ *
+ * @param values The array to reorder.
+ * @param size The size of each value in bytes.
+ * @param idx A permutation of 0..n-1, for example from argsort().
+ * @param n The number of values.
+ * @return 0 on success, -1 if the arguments are invalid, idx is not a permutation of 0..n-1
+ *         (values are then left unchanged) or memory cannot be allocated.
+ */
+int sort_permute(void *values, size_t size, const int *idx, int n) {
+    if (n < 0 || (n > 0 && (values == NULL || idx == NULL))) {
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    size_t words = ((size_t)n + 63) / 64;
+    uint64_t *done = calloc(words, sizeof(uint64_t));
+    char *saved = malloc(size > 0 ? size : 1);
+    if (done == NULL || saved == NULL) {
+        free(done);
+        free(saved);
+        return -1;
+    }
+
+    // Every index must be in range and appear once, or the cycles below would not close
+    for (int i = 0; i < n; i++) {
+        int k = idx[i];
+        if (k < 0 || k >= n || (done[k / 64] >> (k % 64) & 1)) {
+            free(done);
+            free(saved);
+            return -1;
+        }
+        done[k / 64] |= (uint64_t)1 << (k % 64);
+    }
+    memset(done, 0, words * sizeof(uint64_t));
+
+    char *base = values;
+    for (int start = 0; start < n; start++) {
+        if ((done[start / 64] >> (start % 64) & 1) || idx[start] == start) {
+            continue;
+        }
+        memcpy(saved, base + (size_t)start * size, size);
+        int i = start;
+        while (idx[i] != start) {
+            memcpy(base + (size_t)i * size, base + (size_t)idx[i] * size, size);
+            done[i / 64] |= (uint64_t)1 << (i % 64);
+            i = idx[i];
+        }
+        memcpy(base + (size_t)i * size, saved, size);
+        done[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+    free(done);
+    free(saved);
+    return 0;
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief A database row, sorted by its key through argsort() and sort_permute().
+ */
+typedef struct {
+    int key;
+    int row_id;
+    char payload[24];
+} row_t;
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Driver code to demonstrate sort_kv, argsort and sort_permute.
+ *
+ * Every engine is checked against qsort() on the keys, for keeping each value with its key,
+ * and (for the stable engines) for keeping equal keys in their original order.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int keys1[] = {30, -10, 20, 10, -10};
+    int values1[] = {0, 1, 2, 3, 4};
+    sort_kv(keys1, values1, 5, SORT_KV_MERGE);
+    sort_print_array(keys1, 5);
+    sort_print_array(values1, 5);
+    int expected_values1[] = {1, 4, 3, 2, 0};
+    for (int i = 0; i < 5; i++) {
+        assert(values1[i] == expected_values1[i]);
+    }
+    assert(sort_kv(keys1, values1, 5, SORT_KV_ENGINE_COUNT) == -1);
+
+    enum { N = 50000 };
+    static int orig[N], keys[N], values[N], ref[N], idx[N];
+    static int seen[N];
+    srand(31);
+
+    for (int engine = 0; engine < SORT_KV_ENGINE_COUNT; engine++) {
+        int stable = engine == SORT_KV_MERGE || engine == SORT_KV_RADIX;
+        for (long long range = 10; range <= 1000000000; range *= 1000) {
+            for (int i = 0; i < N; i++) {
+                orig[i] = (int)(rand() % range - range / 2);
+            }
+            memcpy(keys, orig, sizeof(keys));
+            memcpy(ref, orig, sizeof(ref));
+            for (int i = 0; i < N; i++) values[i] = i;
+
+            assert(sort_kv(keys, values, N, engine) == 0);
+            qsort(ref, N, sizeof(int), compare_ints);
+            assert(memcmp(keys, ref, sizeof(keys)) == 0);
+            memset(seen, 0, sizeof(seen));
+            for (int i = 0; i < N; i++) {
+                assert(orig[values[i]] == keys[i]);
+                assert(!seen[values[i]]);
+                seen[values[i]] = 1;
+                if (stable && i > 0 && keys[i - 1] == keys[i]) {
+                    assert(values[i - 1] < values[i]);
+                }
+            }
+
+            assert(argsort(orig, N, idx, engine) == 0);
+            for (int i = 0; i < N; i++) {
+                assert(orig[idx[i]] == ref[i]);
+            }
+        }
+    }
+
+    // Sorting records: the permutation is computed on the keys, then each row moves about once
+    static row_t rows[N];
+    for (int i = 0; i < N; i++) {
+        rows[i].key = rand() % 1000;
+        rows[i].row_id = i;
+        snprintf(rows[i].payload, sizeof(rows[i].payload), "row %d", i);
+        orig[i] = rows[i].key;
+    }
+    assert(argsort(orig, N, idx, SORT_KV_RADIX) == 0);
+    assert(sort_permute(rows, sizeof(row_t), idx, N) == 0);
+    for (int i = 0; i < N; i++) {
+        char expected[24];
+        snprintf(expected, sizeof(expected), "row %d", rows[i].row_id);
+        assert(strcmp(rows[i].payload, expected) == 0);
+        if (i > 0) {
+            assert(rows[i - 1].key < rows[i].key ||
+                   (rows[i - 1].key == rows[i].key && rows[i - 1].row_id < rows[i].row_id));
+        }
+    }
+
+    // Anything but a permutation of 0..n-1 is rejected and leaves the values alone
+    int small[] = {10, 20, 30, 40};
+    int out_of_range[] = {0, 1, 4, 2};
+    int negative[] = {0, -1, 2, 3};
+    int repeated[] = {3, 1, 3, 0};
+    int rotate[] = {1, 2, 3, 0};
+    assert(sort_permute(small, sizeof(int), out_of_range, 4) == -1);
+    assert(sort_permute(small, sizeof(int), negative, 4) == -1);
+    assert(sort_permute(small, sizeof(int), repeated, 4) == -1);
+    assert(small[0] == 10 && small[1] == 20 && small[2] == 30 && small[3] == 40);
+    assert(sort_permute(small, sizeof(int), rotate, 4) == 0);
+    assert(small[0] == 20 && small[1] == 30 && small[2] == 40 && small[3] == 10);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
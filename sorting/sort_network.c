@@ -0,0 +1,436 @@
+/**
+ * @file sort_network.c
+ * @brief SIMD sorting networks for small arrays, selected at run time.
+ *
+ * @details
+ * Once the upper levels of a quick sort or merge sort have split the input, most of the
+ * time goes into sorting many tiny segments, where insertion sort's data-dependent branches
+ * mispredict constantly. A sorting network performs a fixed sequence of compare-exchange
+ * steps instead, and with SIMD a whole vector of them takes one min, one max and one blend.
+ *
+ * sort_network() sorts up to SORT_NETWORK_MAX (64) ints as follows:
+ * - The input is copied into 1, 2, 4 or 8 vectors (AVX2, 8 lanes) or 1, 2 or 4 vectors
+ *   (AVX-512, 16 lanes), padded with INT_MAX.
+ * - Each vector is sorted in-register with a bitonic network: every step permutes the vector
+ *   against itself (lane i meets lane i ^ x), takes min and max, and blends them so that the
+ *   lower lane of each pair keeps the minimum.
+ * - Sorted vectors are merged pairwise with bitonic merges, first between vectors and then
+ *   inside each vector, until the whole block is sorted.
+ *
+ * The kernel is chosen from what the CPU supports (AVX-512F, then AVX2), as detected once by
+ * sort_simd_level(), which the other SIMD code in libsort shares. On other CPUs, or with
+ * compilers without GCC-style target attributes, the fallback is insertion sort, and
+ * sort_network_cutoff() reports a smaller base case size to match.
+ *
+ * quick_sort_simple() and merge_sort_simple() use sort_network() for segments of at most
+ * sort_network_cutoff() elements.
+ *
+ * @section Performance
+ * - Time Complexity: O(n log^2 n) compare-exchanges for n <= 64, done W at a time for W-lane
+ *   vectors, with no data-dependent branches.
+ * - Space Complexity: O(1) - a 64-element stack buffer.
+ *
+ * The network is not stable, which makes no difference for plain ints.
+ *
+ * @reference
+ * - Kenneth E. Batcher, "Sorting networks and their applications", 1968.
+ * - Berenger Bramas, "A Novel Hybrid Quicksort Algorithm Vectorized using AVX-512 on Intel
+ *   Skylake", 2017.
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_NETWORK_X86 1
+#include <immintrin.h>
+#endif
+
+/** Base case size when only the scalar fallback is available. */
+#define SORT_NETWORK_SCALAR_CUTOFF 16
+
+/**
+ * @brief Scalar fallback: insertion sort.
+ */
+static void network_scalar(int *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+#ifdef SORT_NETWORK_X86
+
+/* ---- AVX2: 8 lanes per vector, up to 8 vectors ---- */
+
+/**
+ * @brief One compare-exchange step: lane i meets lane i ^ x; lanes with bit m set keep the max.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2_step(__m256i v, int x, int m) {
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i partner = _mm256_permutevar8x32_epi32(v, _mm256_xor_si256(iota, _mm256_set1_epi32(x)));
+    __m256i bit = _mm256_set1_epi32(m);
+    __m256i upper = _mm256_cmpeq_epi32(_mm256_and_si256(iota, bit), bit);
+
+    return _mm256_blendv_epi8(_mm256_min_epi32(v, partner), _mm256_max_epi32(v, partner), upper);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_reverse(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/**
+ * @brief Sorts the 8 lanes of a vector.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2_sort_vector(__m256i v) {
+    for (int k = 2; k <= 8; k *= 2) {
+        v = avx2_step(v, k - 1, k / 2);
+        for (int d = k / 4; d >= 1; d /= 2) {
+            v = avx2_step(v, d, d);
+        }
+    }
+    return v;
+}
+
+/**
+ * @brief Sorts a vector whose lanes form a bitonic sequence.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2_clean_vector(__m256i v) {
+    for (int d = 4; d >= 1; d /= 2) {
+        v = avx2_step(v, d, d);
+    }
+    return v;
+}
+
+/**
+ * @brief Merges v[0..cnt/2) and v[cnt/2..cnt), each sorted, into sorted v[0..cnt).
+ */
+__attribute__((target("avx2")))
+static void avx2_merge(__m256i *v, int cnt) {
+    // Lane l of v[i] meets lane 7 - l of v[cnt - 1 - i]
+    for (int i = 0; i < cnt / 2; i++) {
+        int j = cnt - 1 - i;
+        __m256i r = avx2_reverse(v[j]);
+        __m256i lo = _mm256_min_epi32(v[i], r);
+        __m256i hi = _mm256_max_epi32(v[i], r);
+        v[i] = lo;
+        v[j] = avx2_reverse(hi);
+    }
+    // Half-cleaners at vector distances, then inside each vector
+    for (int d = cnt / 4; d >= 1; d /= 2) {
+        for (int i = 0; i < cnt; i++) {
+            if ((i & d) == 0) {
+                __m256i lo = _mm256_min_epi32(v[i], v[i + d]);
+                __m256i hi = _mm256_max_epi32(v[i], v[i + d]);
+                v[i] = lo;
+                v[i + d] = hi;
+            }
+        }
+    }
+    for (int i = 0; i < cnt; i++) {
+        v[i] = avx2_clean_vector(v[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+static void network_avx2(int *arr, int n) {
+    int buf[SORT_NETWORK_MAX];
+    __m256i v[SORT_NETWORK_MAX / 8];
+    int cnt = 1;
+
+    while (cnt * 8 < n) {
+        cnt *= 2;
+    }
+    memcpy(buf, arr, n * sizeof(int));
+    for (int i = n; i < cnt * 8; i++) {
+        buf[i] = INT_MAX;
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        v[i] = avx2_sort_vector(_mm256_loadu_si256((const __m256i *)(buf + 8 * i)));
+    }
+    for (int s = 2; s <= cnt; s *= 2) {
+        for (int g = 0; g < cnt; g += s) {
+            avx2_merge(v + g, s);
+        }
+    }
+    for (int i = 0; i < cnt; i++) {
+        _mm256_storeu_si256((__m256i *)(buf + 8 * i), v[i]);
+    }
+    memcpy(arr, buf, n * sizeof(int));
+}
+
+/* ---- AVX-512: 16 lanes per vector, up to 4 vectors ---- */
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512_step(__m512i v, int x, int m) {
+    const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i partner = _mm512_permutexvar_epi32(_mm512_xor_si512(iota, _mm512_set1_epi32(x)), v);
+    __mmask16 upper = _mm512_test_epi32_mask(iota, _mm512_set1_epi32(m));
+
+    return _mm512_mask_mov_epi32(_mm512_min_epi32(v, partner), upper,
+                                 _mm512_max_epi32(v, partner));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512_reverse(__m512i v) {
+    return _mm512_permutexvar_epi32(
+        _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), v);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512_sort_vector(__m512i v) {
+    for (int k = 2; k <= 16; k *= 2) {
+        v = avx512_step(v, k - 1, k / 2);
+        for (int d = k / 4; d >= 1; d /= 2) {
+            v = avx512_step(v, d, d);
+        }
+    }
+    return v;
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512_clean_vector(__m512i v) {
+    for (int d = 8; d >= 1; d /= 2) {
+        v = avx512_step(v, d, d);
+    }
+    return v;
+}
+
+__attribute__((target("avx512f")))
+static void avx512_merge(__m512i *v, int cnt) {
+    for (int i = 0; i < cnt / 2; i++) {
+        int j = cnt - 1 - i;
+        __m512i r = avx512_reverse(v[j]);
+        __m512i lo = _mm512_min_epi32(v[i], r);
+        __m512i hi = _mm512_max_epi32(v[i], r);
+        v[i] = lo;
+        v[j] = avx512_reverse(hi);
+    }
+    for (int d = cnt / 4; d >= 1; d /= 2) {
+        for (int i = 0; i < cnt; i++) {
+            if ((i & d) == 0) {
+                __m512i lo = _mm512_min_epi32(v[i], v[i + d]);
+                __m512i hi = _mm512_max_epi32(v[i], v[i + d]);
+                v[i] = lo;
+                v[i + d] = hi;
+            }
+        }
+    }
+    for (int i = 0; i < cnt; i++) {
+        v[i] = avx512_clean_vector(v[i]);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void network_avx512(int *arr, int n) {
+    int buf[SORT_NETWORK_MAX];
+    __m512i v[SORT_NETWORK_MAX / 16];
+    int cnt = 1;
+
+    while (cnt * 16 < n) {
+        cnt *= 2;
+    }
+    memcpy(buf, arr, n * sizeof(int));
+    for (int i = n; i < cnt * 16; i++) {
+        buf[i] = INT_MAX;
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        v[i] = avx512_sort_vector(_mm512_loadu_si512(buf + 16 * i));
+    }
+    for (int s = 2; s <= cnt; s *= 2) {
+        for (int g = 0; g < cnt; g += s) {
+            avx512_merge(v + g, s);
+        }
+    }
+    for (int i = 0; i < cnt; i++) {
+        _mm512_storeu_si512(buf + 16 * i, v[i]);
+    }
+    memcpy(arr, buf, n * sizeof(int));
+}
+
+#endif /* SORT_NETWORK_X86 */
+
+/**
+ * @brief A small-array kernel and the largest segment worth handing to it.
+ */
+typedef struct {
+    void (*sort)(int *arr, int n);
+    int cutoff;
+    const char *isa;
+} network_kernel_t;
+
+static const network_kernel_t kernel_scalar = {network_scalar, SORT_NETWORK_SCALAR_CUTOFF, "scalar"};
+#ifdef SORT_NETWORK_X86
+static const network_kernel_t kernel_avx2 = {network_avx2, SORT_NETWORK_MAX, "avx2"};
+static const network_kernel_t kernel_avx512 = {network_avx512, SORT_NETWORK_MAX, "avx512"};
+#endif
+
+static int simd_level = -1;
+
+/**
+ * @brief Detects the SIMD instruction sets usable by libsort, once.
+ *
+ * Concurrent first calls all store the same value, so a relaxed atomic is enough.
+ *
+ * @return SORT_SIMD_AVX512, SORT_SIMD_AVX2 or SORT_SIMD_NONE.
+ */
+int sort_simd_level(void) {
+    int level = __atomic_load_n(&simd_level, __ATOMIC_RELAXED);
+
+    if (level < 0) {
+        level = SORT_SIMD_NONE;
+#ifdef SORT_NETWORK_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            level = SORT_SIMD_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            level = SORT_SIMD_AVX2;
+        }
+#endif
+        __atomic_store_n(&simd_level, level, __ATOMIC_RELAXED);
+    }
+    return level;
+}
+
+/**
+ * @brief Returns the best kernel for this CPU.
+ */
+static const network_kernel_t *network_kernel(void) {
+#ifdef SORT_NETWORK_X86
+    switch (sort_simd_level()) {
+    case SORT_SIMD_AVX512:
+        return &kernel_avx512;
+    case SORT_SIMD_AVX2:
+        return &kernel_avx2;
+    }
+#endif
+    return &kernel_scalar;
+}
+
+/**
+ * @brief Sorts a small array with the fastest sorting network the CPU supports.
+ *
+ * Arrays larger than SORT_NETWORK_MAX are handed to intro_sort().
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void sort_network(int *arr, int n) {
+    if (n < 2) {
+        return;
+    }
+    if (n > SORT_NETWORK_MAX) {
+        intro_sort(arr, n);
+        return;
+    }
+    network_kernel()->sort(arr, n);
+}
+
+/**
+ * @brief Returns the largest segment size that recursive sorts should hand to sort_network().
+ *
+ * @return SORT_NETWORK_MAX with a SIMD kernel, a smaller value with the scalar fallback.
+ */
+int sort_network_cutoff(void) {
+    return network_kernel()->cutoff;
+}
+
+/**
+ * @brief Returns the name of the kernel in use: "avx512", "avx2" or "scalar".
+ */
+const char *sort_network_isa(void) {
+    return network_kernel()->isa;
+}
+
+#ifdef SORT_DEMO
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Checks one kernel against qsort() for every size from 0 to SORT_NETWORK_MAX.
+ */
+static void check_kernel(const network_kernel_t *kernel) {
+    int arr[SORT_NETWORK_MAX], ref[SORT_NETWORK_MAX];
+
+    for (int trial = 0; trial < 200; trial++) {
+        for (int n = 0; n <= SORT_NETWORK_MAX; n++) {
+            int range = trial % 2 ? 10 : INT_MAX;
+            for (int i = 0; i < n; i++) {
+                arr[i] = rand() % range - range / 2;
+            }
+            if (trial == 0 && n > 0) {
+                arr[0] = INT_MAX; // Must survive next to the INT_MAX padding
+                arr[n - 1] = INT_MIN;
+            }
+            memcpy(ref, arr, n * sizeof(int));
+            kernel->sort(arr, n);
+            qsort(ref, n, sizeof(int), compare_ints);
+            assert(memcmp(arr, ref, n * sizeof(int)) == 0);
+        }
+    }
+    printf("%s kernel ok\n", kernel->isa);
+}
+
+/**
+ * @brief Driver code to demonstrate sort_network and check every kernel this CPU can run.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {64, 34, 25, 12, 22, 11, 90, 5, -7};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    sort_network(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {-7, 5, 11, 12, 22, 25, 34, 64, 90};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+    printf("Using the %s kernel, cutoff %d.\n", sort_network_isa(), sort_network_cutoff());
+
+    srand(37);
+    check_kernel(&kernel_scalar);
+#ifdef SORT_NETWORK_X86
+    if (__builtin_cpu_supports("avx2"))
+        check_kernel(&kernel_avx2);
+    if (__builtin_cpu_supports("avx512f"))
+        check_kernel(&kernel_avx512);
+#endif
+
+    // The recursive sorts that use the network as their base case
+    enum { N = 100000 };
+    static int big[N], ref[N];
+    for (int i = 0; i < N; i++) big[i] = rand() - RAND_MAX / 2;
+    memcpy(ref, big, sizeof(big));
+    qsort(ref, N, sizeof(int), compare_ints);
+    quick_sort_simple(big, N);
+    assert(memcmp(big, ref, sizeof(big)) == 0);
+    for (int i = 0; i < N; i++) big[i] = ref[(i * 7919) % N];
+    merge_sort_simple(big, N);
+    assert(memcmp(big, ref, sizeof(big)) == 0);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,419 @@
+/**
+ * @file sort_pool.c
+ * @brief Work-stealing thread pool used by the parallel sorts.
+ *
+ * @details
+ * Each participating thread has a deque of task pointers protected by its own mutex. The
+ * owner works at the bottom of its deque and thieves take from the top, so in a divide and
+ * conquer sort the thieves pick up the biggest pending sub-problems. The last deque is
+ * shared by all threads that do not belong to the pool.
+ *
+ * Idle workers sleep on a single condition variable and are woken whenever a task is queued.
+ * The same condition variable is used by threads sleeping in sort_pool_wait(); a finishing
+ * task only touches it when somebody is actually asleep waiting for that task.
+ *
+ * See sort_pool.h for the interface.
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "sort_pool.h"
+
+/** Initial capacity of each deque. */
+#define SORT_POOL_DEQUE_CAPACITY 64
+
+/* Values of sort_task_t.state */
+#define TASK_PENDING 0
+#define TASK_DONE 1
+#define TASK_SLEEPER 2 /* Pending, and a thread is asleep in sort_pool_wait() for it */
+
+/**
+ * @brief Double-ended queue of tasks, stored as a growable ring buffer.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    sort_task_t **tasks;
+    int capacity;
+    int head; /**< Index of the oldest task (stolen first). */
+    int count;
+} sort_deque_t;
+
+/**
+ * @brief Identity of a pool thread, stored in thread-specific data.
+ */
+typedef struct {
+    sort_pool_t *pool;
+    int index;
+} sort_worker_t;
+
+struct sort_pool {
+    int num_workers;         /**< Background threads that were started. */
+    int num_slots;           /**< Number of deques; the last one is shared. */
+    pthread_t *threads;
+    sort_worker_t *workers;
+    sort_deque_t *deques;
+    pthread_mutex_t lock;    /**< Protects sleeping on wake. */
+    pthread_cond_t wake;
+    int queued;              /**< Tasks sitting in any deque (accessed atomically). */
+    int shutdown;
+};
+
+static pthread_key_t worker_key;
+static pthread_once_t worker_key_once = PTHREAD_ONCE_INIT;
+
+static sort_pool_t *default_pool;
+static pthread_once_t default_pool_once = PTHREAD_ONCE_INIT;
+
+static void create_worker_key(void) {
+    pthread_key_create(&worker_key, NULL);
+}
+
+static void create_default_pool(void) {
+    const char *env = getenv("SORT_THREADS");
+    default_pool = sort_pool_create(env != NULL ? atoi(env) : 0);
+}
+
+/**
+ * @brief Returns the number of online CPUs, at least 1.
+ */
+static int online_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/**
+ * @brief Appends a task at the bottom of a deque.
+ *
+ * @return 0 on success, -1 if the deque could not grow.
+ */
+static int deque_push(sort_deque_t *dq, sort_task_t *task) {
+    int result = 0;
+
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count == dq->capacity) {
+        int new_capacity = dq->capacity * 2;
+        sort_task_t **grown = malloc(new_capacity * sizeof(*grown));
+        if (grown == NULL) {
+            result = -1;
+        } else {
+            // Unwrap the ring into the new buffer
+            for (int i = 0; i < dq->count; i++) {
+                grown[i] = dq->tasks[(dq->head + i) % dq->capacity];
+            }
+            free(dq->tasks);
+            dq->tasks = grown;
+            dq->capacity = new_capacity;
+            dq->head = 0;
+        }
+    }
+    if (result == 0) {
+        dq->tasks[(dq->head + dq->count) % dq->capacity] = task;
+        dq->count++;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return result;
+}
+
+/**
+ * @brief Removes the newest task (owner side) or the oldest task (thief side).
+ *
+ * @param dq The deque.
+ * @param steal Nonzero to take from the top instead of the bottom.
+ * @return The task, or NULL if the deque was empty.
+ */
+static sort_task_t *deque_take(sort_deque_t *dq, int steal) {
+    sort_task_t *task = NULL;
+
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count > 0) {
+        if (steal) {
+            task = dq->tasks[dq->head];
+            dq->head = (dq->head + 1) % dq->capacity;
+        } else {
+            task = dq->tasks[(dq->head + dq->count - 1) % dq->capacity];
+        }
+        dq->count--;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return task;
+}
+
+/**
+ * @brief Returns the deque the calling thread pushes to and pops from.
+ */
+static int home_deque(const sort_pool_t *pool) {
+    const sort_worker_t *self = pthread_getspecific(worker_key);
+    if (self != NULL && self->pool == pool) {
+        return self->index;
+    }
+    return pool->num_slots - 1;
+}
+
+/**
+ * @brief Takes a task from the home deque, or steals one from any other deque.
+ *
+ * @return A task, or NULL if every deque is empty.
+ */
+static sort_task_t *find_task(sort_pool_t *pool, int home) {
+    int num_deques = pool->num_slots;
+    sort_task_t *task = deque_take(&pool->deques[home], 0);
+
+    for (int i = 1; task == NULL && i < num_deques; i++) {
+        task = deque_take(&pool->deques[(home + i) % num_deques], 1);
+    }
+    if (task != NULL) {
+        __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+    }
+    return task;
+}
+
+/**
+ * @brief Runs a task and wakes whoever is asleep waiting for it.
+ */
+static void run_task(sort_pool_t *pool, sort_task_t *task) {
+    task->fn(task->arg);
+    // The waiter may return and reuse the task's memory as soon as it sees TASK_DONE,
+    // so learn whether anyone sleeps on it in the same atomic step
+    if (__atomic_exchange_n(&task->state, TASK_DONE, __ATOMIC_SEQ_CST) == TASK_SLEEPER) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * @brief Main loop of a background thread.
+ */
+static void *worker_main(void *arg) {
+    sort_worker_t *self = arg;
+    sort_pool_t *pool = self->pool;
+
+    pthread_setspecific(worker_key, self);
+    for (;;) {
+        sort_task_t *task = find_task(pool, self->index);
+        if (task != NULL) {
+            run_task(pool, task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        int stop = pool->shutdown;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+sort_pool_t *sort_pool_create(int num_threads) {
+    pthread_once(&worker_key_once, create_worker_key);
+    if (num_threads < 1) {
+        num_threads = online_cpus();
+    }
+
+    sort_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->num_workers = num_threads - 1;
+    pool->num_slots = num_threads;
+    pool->threads = calloc(num_threads, sizeof(*pool->threads));
+    pool->workers = calloc(num_threads, sizeof(*pool->workers));
+    pool->deques = calloc(num_threads, sizeof(*pool->deques));
+    if (pool->threads == NULL || pool->workers == NULL || pool->deques == NULL) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    for (int i = 0; i < pool->num_slots; i++) {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+        pool->deques[i].capacity = SORT_POOL_DEQUE_CAPACITY;
+        pool->deques[i].tasks = malloc(SORT_POOL_DEQUE_CAPACITY * sizeof(sort_task_t *));
+        if (pool->deques[i].tasks == NULL) {
+            pool->deques[i].capacity = 0;
+        }
+    }
+
+    // Start the background threads; if one fails, run with the ones that did start
+    int started = 0;
+    for (int i = 0; i < pool->num_workers; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (pool->deques[i].capacity == 0 ||
+            pthread_create(&pool->threads[i], NULL, worker_main, &pool->workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    pool->num_workers = started;
+    return pool;
+}
+
+void sort_pool_destroy(sort_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    for (int i = 0; i < pool->num_slots; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].tasks);
+    }
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->deques);
+    free(pool);
+}
+
+sort_pool_t *sort_pool_default(void) {
+    pthread_once(&default_pool_once, create_default_pool);
+    return default_pool;
+}
+
+int sort_pool_threads(const sort_pool_t *pool) {
+    return pool == NULL ? 1 : pool->num_workers + 1;
+}
+
+void sort_pool_spawn(sort_pool_t *pool, sort_task_t *task, void (*fn)(void *), void *arg) {
+    task->fn = fn;
+    task->arg = arg;
+    task->state = TASK_PENDING;
+
+    sort_deque_t *dq = pool != NULL ? &pool->deques[home_deque(pool)] : NULL;
+    if (dq == NULL || dq->capacity == 0 || deque_push(dq, task) != 0) {
+        // No pool or no room: run it right here
+        fn(arg);
+        task->state = TASK_DONE;
+        return;
+    }
+
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void sort_pool_wait(sort_pool_t *pool, sort_task_t *task) {
+    if (pool == NULL) {
+        return;
+    }
+
+    int home = home_deque(pool);
+    while (__atomic_load_n(&task->state, __ATOMIC_SEQ_CST) != TASK_DONE) {
+        // Help out; with LIFO popping this usually runs the awaited task itself
+        sort_task_t *other = find_task(pool, home);
+        if (other != NULL) {
+            run_task(pool, other);
+            continue;
+        }
+
+        // Nothing to do: the task is running elsewhere, sleep until it or new work arrives
+        int expected = TASK_PENDING;
+        pthread_mutex_lock(&pool->lock);
+        __atomic_compare_exchange_n(&task->state, &expected, TASK_SLEEPER, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&task->state, __ATOMIC_SEQ_CST) != TASK_DONE &&
+               __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Recursive fork/join sum used to exercise the pool.
+ */
+typedef struct {
+    sort_pool_t *pool;
+    const int *arr;
+    int n;
+    long long sum;
+} sum_job_t;
+
+static void parallel_sum(void *arg) {
+    sum_job_t *job = arg;
+
+    if (job->n <= 1000) {
+        job->sum = 0;
+        for (int i = 0; i < job->n; i++) {
+            job->sum += job->arr[i];
+        }
+        return;
+    }
+
+    int half = job->n / 2;
+    sum_job_t left = {job->pool, job->arr, half, 0};
+    sum_job_t right = {job->pool, job->arr + half, job->n - half, 0};
+    sort_task_t task;
+
+    sort_pool_spawn(job->pool, &task, parallel_sum, &left);
+    parallel_sum(&right);
+    sort_pool_wait(job->pool, &task);
+    job->sum = left.sum + right.sum;
+}
+
+/**
+ * @brief Driver code to demonstrate the pool with a nested fork/join computation.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    enum { N = 1000000 };
+    static int arr[N];
+    long long expected = 0;
+
+    for (int i = 0; i < N; i++) {
+        arr[i] = i % 1000;
+        expected += arr[i];
+    }
+
+    int sizes[] = {1, 2, 4, 0};
+    for (int s = 0; s < 4; s++) {
+        sort_pool_t *pool = sort_pool_create(sizes[s]);
+        assert(pool != NULL);
+        sum_job_t job = {pool, arr, N, 0};
+        parallel_sum(&job);
+        printf("threads=%d sum=%lld\n", sort_pool_threads(pool), job.sum);
+        assert(job.sum == expected);
+        sort_pool_destroy(pool);
+    }
+
+    // A NULL pool runs everything on the caller
+    sum_job_t job = {NULL, arr, N, 0};
+    parallel_sum(&job);
+    assert(job.sum == expected);
+
+    assert(sort_pool_default() == sort_pool_default());
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
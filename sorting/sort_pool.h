@@ -0,0 +1,90 @@
+/**
+ * @file sort_pool.h
+ * @brief Work-stealing thread pool used by the parallel sorts.
+ *
+ * @details
+ * The pool provides fork/join parallelism: a task is spawned with sort_pool_spawn() and later
+ * joined with sort_pool_wait(). Every pool thread owns a deque; it pushes and pops its own
+ * tasks at the bottom (newest first) and steals from the top of the other deques (oldest,
+ * i.e. largest, first) when it runs dry. Threads that are not part of the pool share one
+ * extra deque, so a parallel sort can be started from any thread.
+ *
+ * A thread blocked in sort_pool_wait() does not idle: it keeps running queued tasks until the
+ * one it waits for has finished. This makes nested spawn/wait safe and lets the calling
+ * thread count as one of the pool's workers.
+ *
+ * Tasks live in memory owned by the caller (usually the spawning function's stack frame),
+ * so spawning does not allocate.
+ */
+
+#ifndef SORT_POOL_H
+#define SORT_POOL_H
+
+typedef struct sort_pool sort_pool_t;
+
+/**
+ * @brief A unit of work for the pool. Treat the members as private.
+ */
+typedef struct {
+    void (*fn)(void *arg); /**< Function to run. */
+    void *arg;             /**< Argument passed to fn. */
+    int state;             /**< Pending, done or waited on (accessed atomically). */
+} sort_task_t;
+
+/**
+ * @brief Creates a pool.
+ *
+ * @param num_threads Total number of threads that may work on a sort, including the caller;
+ *                    num_threads - 1 background threads are started. Values below 1 mean the
+ *                    number of online CPUs.
+ * @return The new pool, or NULL if it could not be created.
+ */
+sort_pool_t *sort_pool_create(int num_threads);
+
+/**
+ * @brief Stops the background threads and frees the pool. No task may still be pending.
+ *
+ * @param pool The pool, may be NULL.
+ */
+void sort_pool_destroy(sort_pool_t *pool);
+
+/**
+ * @brief Returns the process-wide pool, created on first use with one thread per online CPU.
+ *
+ * The SORT_THREADS environment variable, if set when the pool is created, overrides the
+ * number of threads.
+ *
+ * @return The shared pool, or NULL if it could not be created.
+ */
+sort_pool_t *sort_pool_default(void);
+
+/**
+ * @brief Returns the number of threads (including the caller) that can work on the pool.
+ *
+ * @param pool The pool, may be NULL (counts as 1).
+ * @return The number of threads.
+ */
+int sort_pool_threads(const sort_pool_t *pool);
+
+/**
+ * @brief Queues fn(arg) to run on the pool.
+ *
+ * If pool is NULL, or the task cannot be queued, fn runs immediately on the calling thread.
+ * Either way the task must later be passed to sort_pool_wait().
+ *
+ * @param pool The pool, may be NULL.
+ * @param task Storage for the task; must stay valid until sort_pool_wait() returns.
+ * @param fn Function to run.
+ * @param arg Argument passed to fn.
+ */
+void sort_pool_spawn(sort_pool_t *pool, sort_task_t *task, void (*fn)(void *), void *arg);
+
+/**
+ * @brief Waits until a spawned task has finished, running other queued tasks meanwhile.
+ *
+ * @param pool The pool the task was spawned on, may be NULL.
+ * @param task The task.
+ */
+void sort_pool_wait(sort_pool_t *pool, sort_task_t *task);
+
+#endif /* SORT_POOL_H */
@@ -0,0 +1,208 @@
+/**
+ * @file sort_template.h
+ * @brief Macro that generates an introsort specialized for one element type and ordering.
+ *
+ * @details
+ * sort_generic() has the same interface as qsort(), and like qsort() it pays for an
+ * indirect comparator call and a byte-wise swap on every step. SORT_DEFINE() instead
+ * generates a complete introsort for a given element type with the comparison written out
+ * as a macro, so the compiler inlines it and moves elements with plain assignments. libsort
+ * instantiates it for the common key types (sort_i32(), sort_i64(), sort_f32(), sort_f64(),
+ * sort_ptr()); code that sorts its own structs can instantiate it the same way.
+ *
+ * SORT_DEFINE_KV() generates the same sort for a key array with a parallel value array
+ * (struct-of-arrays): only the keys are compared, and every move of a key is applied to its
+ * value too. sort_kv() in sort_kv.c is built on it.
+ *
+ * The generated sort uses a median-of-three Hoare partition, recurses into the smaller side,
+ * switches to heap sort past 2 * log2(n) levels and finishes segments of at most
+ * SORT_TEMPLATE_THRESHOLD elements with insertion sort. It is not stable.
+ *
+ * @section Example Usage
+ * @code
+ * #include "sort_template.h"
+ *
+ * struct order { long id; double price; };
+ * #define ORDER_LESS(a, b) ((a).price < (b).price)
+ *
+ * SORT_DEFINE(static, sort_orders_by_price, struct order, ORDER_LESS)
+ *
+ * sort_orders_by_price(orders, count);
+ * @endcode
+ */
+
+#ifndef SORT_TEMPLATE_H
+#define SORT_TEMPLATE_H
+
+#include <stddef.h>
+
+/** Segments of this size or smaller are finished with insertion sort. */
+#define SORT_TEMPLATE_THRESHOLD 16
+
+/** Natural ordering of arithmetic types. */
+#define SORT_LESS(a, b) ((a) < (b))
+
+/** Ordering of floating point values with NaNs after every number (and equal to each other). */
+#define SORT_LESS_FLOAT(a, b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+
+/**
+ * @brief Defines `scope void name(type *arr, size_t n)`, an introsort over type ordered by less.
+ *
+ * @param scope Linkage of the sort function: `static`, or empty for external linkage.
+ * @param name Name of the sort function; helpers are named name_insertion, name_partition, ...
+ * @param type Element type; elements are moved by assignment.
+ * @param less Name of a function-like macro (or function) less(x, y) that is nonzero if x
+ *             must come before y. It has to be a strict weak ordering.
+ */
+#define SORT_DEFINE(scope, name, type, less)                                                   \
+    SORT_DEFINE_BODY_(name, type, char, less, 0)                                               \
+                                                                                               \
+    scope void name(type *arr, size_t n) {                                                     \
+        name##_introsort(arr, NULL, n);                                                        \
+    }
+
+/**
+ * @brief Defines `scope void name(key_type *keys, value_type *values, size_t n)`, the same
+ *        introsort over keys, applying every move to the parallel array values as well.
+ *
+ * The values are never compared. Besides name itself, name_heap_sort(keys, values, n) and
+ * name_insertion(keys, values, n) are available to the rest of the file.
+ */
+#define SORT_DEFINE_KV(scope, name, key_type, value_type, less)                                \
+    SORT_DEFINE_BODY_(name, key_type, value_type, less, 1)                                     \
+                                                                                               \
+    scope void name(key_type *keys, value_type *values, size_t n) {                            \
+        name##_introsort(keys, values, n);                                                     \
+    }
+
+/*
+ * The rest of this file is shared by the macros above and by libsort's own key-value sorts.
+ * carry is the constant 1 when a value array travels with the keys and 0 when there is none
+ * (values is then NULL), so the value moves compile away in the plain sorts.
+ */
+
+/** values + k when values are carried, values itself otherwise (it may be NULL then). */
+#define SORT_VALUES_AT_(carry, values, k) ((carry) ? (values) + (k) : (values))
+
+/**
+ * @brief Defines name_insertion(keys, values, n), a stable insertion sort.
+ */
+#define SORT_DEFINE_INSERTION_(name, key_type, value_type, less, carry)                        \
+    static void name##_insertion(key_type *keys, value_type *values, size_t n) {               \
+        for (size_t i = 1; i < n; i++) {                                                       \
+            key_type key = keys[i];                                                            \
+            value_type value;                                                                  \
+            if (carry)                                                                         \
+                value = values[i];                                                             \
+            size_t j = i;                                                                      \
+            while (j > 0 && less(key, keys[j - 1])) {                                          \
+                keys[j] = keys[j - 1];                                                         \
+                if (carry)                                                                     \
+                    values[j] = values[j - 1];                                                 \
+                j--;                                                                           \
+            }                                                                                  \
+            keys[j] = key;                                                                     \
+            if (carry)                                                                         \
+                values[j] = value;                                                             \
+        }                                                                                      \
+    }
+
+/**
+ * @brief Defines name_introsort(keys, values, n) and the helpers it is built from.
+ */
+#define SORT_DEFINE_BODY_(name, key_type, value_type, less, carry)                             \
+    static inline void name##_swap(key_type *keys, value_type *values, size_t i, size_t j) {   \
+        key_type key = keys[i];                                                                \
+        keys[i] = keys[j];                                                                     \
+        keys[j] = key;                                                                         \
+        if (carry) {                                                                           \
+            value_type value = values[i];                                                      \
+            values[i] = values[j];                                                             \
+            values[j] = value;                                                                 \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    SORT_DEFINE_INSERTION_(name, key_type, value_type, less, carry)                            \
+                                                                                               \
+    static void name##_sift_down(key_type *keys, value_type *values, size_t root, size_t n) {  \
+        for (;;) {                                                                             \
+            size_t child = 2 * root + 1;                                                       \
+            if (child >= n)                                                                    \
+                break;                                                                         \
+            if (child + 1 < n && less(keys[child], keys[child + 1]))                           \
+                child++;                                                                       \
+            if (!less(keys[root], keys[child]))                                                \
+                break;                                                                         \
+            name##_swap(keys, values, root, child);                                            \
+            root = child;                                                                      \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    static void name##_heap_sort(key_type *keys, value_type *values, size_t n) {               \
+        if (n < 2)                                                                             \
+            return;                                                                            \
+        for (size_t i = n / 2; i-- > 0;)                                                       \
+            name##_sift_down(keys, values, i, n);                                              \
+        for (size_t end = n - 1; end > 0; end--) {                                             \
+            name##_swap(keys, values, 0, end);                                                 \
+            name##_sift_down(keys, values, 0, end);                                            \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    /* Partitions keys[0..n), n >= 3, and returns the final index of the pivot */              \
+    static size_t name##_partition(key_type *keys, value_type *values, size_t n) {             \
+        size_t mid = n / 2;                                                                    \
+        if (less(keys[mid], keys[0]))                                                          \
+            name##_swap(keys, values, mid, 0);                                                 \
+        if (less(keys[n - 1], keys[0]))                                                        \
+            name##_swap(keys, values, n - 1, 0);                                               \
+        if (less(keys[n - 1], keys[mid]))                                                      \
+            name##_swap(keys, values, n - 1, mid);                                             \
+        name##_swap(keys, values, 0, mid);                                                     \
+                                                                                               \
+        key_type pivot = keys[0];                                                              \
+        size_t i = 0, j = n;                                                                   \
+        for (;;) {                                                                             \
+            do {                                                                               \
+                i++;                                                                           \
+            } while (i < n - 1 && less(keys[i], pivot));                                       \
+            do {                                                                               \
+                j--;                                                                           \
+            } while (less(pivot, keys[j]));                                                    \
+            if (i >= j)                                                                        \
+                break;                                                                         \
+            name##_swap(keys, values, i, j);                                                   \
+        }                                                                                      \
+        name##_swap(keys, values, 0, j);                                                       \
+        return j;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    static void name##_intro(key_type *keys, value_type *values, size_t n, int depth) {        \
+        while (n > SORT_TEMPLATE_THRESHOLD) {                                                  \
+            if (depth-- == 0) {                                                                \
+                name##_heap_sort(keys, values, n);                                             \
+                return;                                                                        \
+            }                                                                                  \
+            size_t p = name##_partition(keys, values, n);                                      \
+            if (p < n - p - 1) {                                                               \
+                name##_intro(keys, values, p, depth);                                          \
+                keys += p + 1;                                                                 \
+                values = SORT_VALUES_AT_(carry, values, p + 1);                                \
+                n -= p + 1;                                                                    \
+            } else {                                                                           \
+                name##_intro(keys + p + 1, SORT_VALUES_AT_(carry, values, p + 1), n - p - 1,   \
+                             depth);                                                           \
+                n = p;                                                                         \
+            }                                                                                  \
+        }                                                                                      \
+        name##_insertion(keys, values, n);                                                     \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_introsort(key_type *keys, value_type *values, size_t n) {        \
+        int depth = 0;                                                                         \
+        for (size_t m = n; m > 1; m >>= 1)                                                     \
+            depth += 2;                                                                        \
+        name##_intro(keys, values, n, depth);                                                  \
+    }
+
+#endif /* SORT_TEMPLATE_H */
@@ -0,0 +1,622 @@
+/**
+ * @file tim_sort.c
+ * @brief Implementation of TimSort, a natural bottom-up merge sort.
+ *
+ * @details
+ * merge_sort_simple.c splits the array in half regardless of its contents, so it does the
+ * same O(n log n) work on sorted input as on random input. TimSort instead merges the runs
+ * that already exist in the data:
+ * - **Run detection**: the array is scanned left to right for maximal non-descending runs
+ *   and strictly descending runs; descending runs are reversed in place (strictness keeps the
+ *   sort stable).
+ * - **Minimum run length**: runs shorter than minrun (between 32 and 64, chosen so that
+ *   n / minrun is close to a power of two) are extended with binary insertion sort.
+ * - **Merge stack**: runs are pushed on a stack whose lengths must satisfy
+ *   len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]; whenever that breaks, adjacent runs
+ *   are merged. This keeps merges balanced and the stack O(log n) deep.
+ * - **Galloping**: when one run keeps winning during a merge, the merge switches to
+ *   exponential search to find how many elements to copy in one block. The threshold
+ *   adapts: it drops while galloping pays off and rises when it does not.
+ *
+ * A single scratch buffer of n / 2 elements is allocated up front; each merge copies only the
+ * shorter of its two runs into it.
+ *
+ * @section Performance
+ * - Best Case Time Complexity: O(n) - when the input is sorted or reverse sorted.
+ * - Average Case Time Complexity: O(n log n)
+ * - Worst Case Time Complexity: O(n log n)
+ * - Space Complexity: O(n)
+ *
+ * The sort is stable.
+ *
+ * @reference
+ * - Tim Peters, "listsort.txt", CPython source distribution.
+ * - Stijn de Gouw et al., "OpenJDK's java.utils.Collection.sort() is broken", CAV 2015
+ *   (the corrected merge_collapse invariant used here).
+ *
+ * Author: Kiran Jojare
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sort.h"
+
+/** Arrays shorter than this are sorted with binary insertion sort alone. */
+#define TIM_SORT_MIN_MERGE 64
+/** Initial number of consecutive wins before a merge starts galloping. */
+#define TIM_SORT_MIN_GALLOP 7
+/** Enough stack for any int-sized array given the run length invariants. */
+#define TIM_SORT_MAX_PENDING 85
+
+/**
+ * @brief A run waiting to be merged.
+ */
+typedef struct {
+    int *base;
+    int len;
+} tim_run_t;
+
+/**
+ * @brief State shared by all merges of one sort.
+ */
+typedef struct {
+    int *tmp;       /**< Scratch buffer for the shorter run of a merge. */
+    int min_gallop; /**< Current galloping threshold. */
+    int num_pending;
+    tim_run_t pending[TIM_SORT_MAX_PENDING];
+} tim_state_t;
+
+/**
+ * @brief Computes the minimum run length for an array of n elements.
+ *
+ * Takes the six most significant bits of n, adding one if any of the remaining bits is set.
+ */
+static int compute_min_run(int n) {
+    int r = 0;
+    while (n >= TIM_SORT_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/**
+ * @brief Reverses arr[0..n) in place.
+ */
+static void reverse_range(int *arr, int n) {
+    for (int i = 0, j = n - 1; i < j; i++, j--) {
+        int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+/**
+ * @brief Returns the length of the run starting at arr[0], making it ascending.
+ *
+ * @param arr The start of the run.
+ * @param n The number of elements available.
+ * @return The run length, at least 1 (or 0 if n is 0).
+ */
+static int count_run_and_make_ascending(int *arr, int n) {
+    int run = 2;
+
+    if (n < 2) {
+        return n;
+    }
+    if (arr[1] < arr[0]) {
+        while (run < n && arr[run] < arr[run - 1]) {
+            run++;
+        }
+        reverse_range(arr, run);
+    } else {
+        while (run < n && arr[run] >= arr[run - 1]) {
+            run++;
+        }
+    }
+    return run;
+}
+
+/**
+ * @brief Sorts arr[0..n) given that arr[0..start) is already sorted.
+ *
+ * Each new element is placed with a binary search (after equal elements, for stability)
+ * and a single block move.
+ */
+static void binary_insertion_sort(int *arr, int n, int start) {
+    if (start == 0) {
+        start = 1;
+    }
+    for (; start < n; start++) {
+        int pivot = arr[start];
+        int left = 0, right = start;
+
+        while (left < right) {
+            int mid = left + (right - left) / 2;
+            if (pivot < arr[mid]) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        memmove(&arr[left + 1], &arr[left], (start - left) * sizeof(int));
+        arr[left] = pivot;
+    }
+}
+
+/**
+ * @brief Finds the leftmost position at which key can be inserted into sorted a[0..len).
+ *
+ * Gallops outward from a[hint] in steps of 1, 3, 7, 15, ... and finishes with a binary
+ * search, so the cost is logarithmic in the distance from hint.
+ *
+ * @return k such that a[k-1] < key <= a[k].
+ */
+static int gallop_left(int key, const int *a, int len, int hint) {
+    int last_ofs = 0, ofs = 1;
+
+    if (key > a[hint]) {
+        // Gallop right until a[hint + last_ofs] < key <= a[hint + ofs]
+        int max_ofs = len - hint;
+        while (ofs < max_ofs && key > a[hint + ofs]) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = max_ofs;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        // Gallop left until a[hint - ofs] < key <= a[hint - last_ofs]
+        int max_ofs = hint + 1;
+        while (ofs < max_ofs && key <= a[hint - ofs]) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = max_ofs;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        int temp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - temp;
+    }
+
+    // Now a[last_ofs] < key <= a[ofs]; binary search the gap
+    last_ofs++;
+    while (last_ofs < ofs) {
+        int mid = last_ofs + ((ofs - last_ofs) >> 1);
+        if (key > a[mid])
+            last_ofs = mid + 1;
+        else
+            ofs = mid;
+    }
+    return ofs;
+}
+
+/**
+ * @brief Like gallop_left(), but returns the rightmost insertion position.
+ *
+ * @return k such that a[k-1] <= key < a[k].
+ */
+static int gallop_right(int key, const int *a, int len, int hint) {
+    int last_ofs = 0, ofs = 1;
+
+    if (key < a[hint]) {
+        // Gallop left until a[hint - ofs] <= key < a[hint - last_ofs]
+        int max_ofs = hint + 1;
+        while (ofs < max_ofs && key < a[hint - ofs]) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = max_ofs;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        int temp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - temp;
+    } else {
+        // Gallop right until a[hint + last_ofs] <= key < a[hint + ofs]
+        int max_ofs = len - hint;
+        while (ofs < max_ofs && key >= a[hint + ofs]) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = max_ofs;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+
+    last_ofs++;
+    while (last_ofs < ofs) {
+        int mid = last_ofs + ((ofs - last_ofs) >> 1);
+        if (key < a[mid])
+            ofs = mid;
+        else
+            last_ofs = mid + 1;
+    }
+    return ofs;
+}
+
+/**
+ * @brief Merges two adjacent runs when the first is the shorter one.
+ *
+ * The first run is copied to the scratch buffer and the merge proceeds left to right.
+ * Requires base2[0] < base1[0] and base1[len1 - 1] > base2[len2 - 1], as established by
+ * merge_at().
+ */
+static void merge_lo(tim_state_t *ts, int *base1, int len1, int *base2, int len2) {
+    int *cursor1 = ts->tmp;
+    int *cursor2 = base2;
+    int *dest = base1;
+    int min_gallop = ts->min_gallop;
+
+    memcpy(ts->tmp, base1, len1 * sizeof(int));
+
+    // The first element of run 2 is known to go first
+    *dest++ = *cursor2++;
+    if (--len2 == 0) {
+        memcpy(dest, cursor1, len1 * sizeof(int));
+        return;
+    }
+    if (len1 == 1) {
+        memmove(dest, cursor2, len2 * sizeof(int));
+        dest[len2] = *cursor1;
+        return;
+    }
+
+    for (;;) {
+        int count1 = 0; // Consecutive wins of run 1
+        int count2 = 0; // Consecutive wins of run 2
+
+        // One element at a time until one run starts winning consistently
+        do {
+            if (*cursor2 < *cursor1) {
+                *dest++ = *cursor2++;
+                count2++;
+                count1 = 0;
+                if (--len2 == 0)
+                    goto done;
+            } else {
+                *dest++ = *cursor1++;
+                count1++;
+                count2 = 0;
+                if (--len1 == 1)
+                    goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        // Galloping mode: copy whole blocks while it keeps paying off
+        do {
+            count1 = gallop_right(*cursor2, cursor1, len1, 0);
+            if (count1 != 0) {
+                memcpy(dest, cursor1, count1 * sizeof(int));
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+                if (len1 <= 1)
+                    goto done;
+            }
+            *dest++ = *cursor2++;
+            if (--len2 == 0)
+                goto done;
+
+            count2 = gallop_left(*cursor1, cursor2, len2, 0);
+            if (count2 != 0) {
+                memmove(dest, cursor2, count2 * sizeof(int));
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+                if (len2 == 0)
+                    goto done;
+            }
+            *dest++ = *cursor1++;
+            if (--len1 == 1)
+                goto done;
+            min_gallop--;
+        } while (count1 >= TIM_SORT_MIN_GALLOP || count2 >= TIM_SORT_MIN_GALLOP);
+
+        // Penalize leaving galloping mode
+        if (min_gallop < 0)
+            min_gallop = 0;
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if (len1 == 1) {
+        // The last element of run 1 goes after the rest of run 2
+        memmove(dest, cursor2, len2 * sizeof(int));
+        dest[len2] = *cursor1;
+    } else {
+        // Run 2 is exhausted
+        memcpy(dest, cursor1, len1 * sizeof(int));
+    }
+}
+
+/**
+ * @brief Merges two adjacent runs when the second is the shorter one.
+ *
+ * The second run is copied to the scratch buffer and the merge proceeds right to left.
+ */
+static void merge_hi(tim_state_t *ts, int *base1, int len1, int *base2, int len2) {
+    int *tmp = ts->tmp;
+    int *cursor1 = base1 + len1 - 1;
+    int *cursor2 = tmp + len2 - 1;
+    int *dest = base2 + len2 - 1;
+    int min_gallop = ts->min_gallop;
+
+    memcpy(tmp, base2, len2 * sizeof(int));
+
+    // The last element of run 1 is known to go last
+    *dest-- = *cursor1--;
+    if (--len1 == 0) {
+        memcpy(dest - (len2 - 1), tmp, len2 * sizeof(int));
+        return;
+    }
+    if (len2 == 1) {
+        dest -= len1;
+        cursor1 -= len1;
+        memmove(dest + 1, cursor1 + 1, len1 * sizeof(int));
+        *dest = *cursor2;
+        return;
+    }
+
+    for (;;) {
+        int count1 = 0;
+        int count2 = 0;
+
+        do {
+            if (*cursor2 < *cursor1) {
+                *dest-- = *cursor1--;
+                count1++;
+                count2 = 0;
+                if (--len1 == 0)
+                    goto done;
+            } else {
+                *dest-- = *cursor2--;
+                count2++;
+                count1 = 0;
+                if (--len2 == 1)
+                    goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        do {
+            count1 = len1 - gallop_right(*cursor2, base1, len1, len1 - 1);
+            if (count1 != 0) {
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                memmove(dest + 1, cursor1 + 1, count1 * sizeof(int));
+                if (len1 == 0)
+                    goto done;
+            }
+            *dest-- = *cursor2--;
+            if (--len2 == 1)
+                goto done;
+
+            count2 = len2 - gallop_left(*cursor1, tmp, len2, len2 - 1);
+            if (count2 != 0) {
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                memcpy(dest + 1, cursor2 + 1, count2 * sizeof(int));
+                if (len2 <= 1)
+                    goto done;
+            }
+            *dest-- = *cursor1--;
+            if (--len1 == 0)
+                goto done;
+            min_gallop--;
+        } while (count1 >= TIM_SORT_MIN_GALLOP || count2 >= TIM_SORT_MIN_GALLOP);
+
+        if (min_gallop < 0)
+            min_gallop = 0;
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if (len2 == 1) {
+        // The first element of run 2 goes before the rest of run 1
+        dest -= len1;
+        cursor1 -= len1;
+        memmove(dest + 1, cursor1 + 1, len1 * sizeof(int));
+        *dest = *cursor2;
+    } else {
+        // Run 1 is exhausted
+        memcpy(dest - (len2 - 1), tmp, len2 * sizeof(int));
+    }
+}
+
+/**
+ * @brief Merges pending runs i and i + 1.
+ */
+static void merge_at(tim_state_t *ts, int i) {
+    int *base1 = ts->pending[i].base;
+    int len1 = ts->pending[i].len;
+    int *base2 = ts->pending[i + 1].base;
+    int len2 = ts->pending[i + 1].len;
+
+    ts->pending[i].len = len1 + len2;
+    if (i == ts->num_pending - 3) {
+        ts->pending[i + 1] = ts->pending[i + 2];
+    }
+    ts->num_pending--;
+
+    // Elements of run 1 that are <= base2[0] are already in place
+    int k = gallop_right(base2[0], base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0)
+        return;
+
+    // Elements of run 2 that are >= the last of run 1 are already in place
+    len2 = gallop_left(base1[len1 - 1], base2, len2, len2 - 1);
+    if (len2 == 0)
+        return;
+
+    if (len1 <= len2)
+        merge_lo(ts, base1, len1, base2, len2);
+    else
+        merge_hi(ts, base1, len1, base2, len2);
+}
+
+/**
+ * @brief Merges runs until the stack invariants hold again.
+ */
+static void merge_collapse(tim_state_t *ts) {
+    tim_run_t *p = ts->pending;
+
+    while (ts->num_pending > 1) {
+        int k = ts->num_pending - 2;
+        if ((k > 0 && p[k - 1].len <= p[k].len + p[k + 1].len) ||
+            (k > 1 && p[k - 2].len <= p[k - 1].len + p[k].len)) {
+            if (p[k - 1].len < p[k + 1].len)
+                k--;
+        } else if (p[k].len > p[k + 1].len) {
+            break;
+        }
+        merge_at(ts, k);
+    }
+}
+
+/**
+ * @brief Merges all remaining runs.
+ */
+static void merge_force_collapse(tim_state_t *ts) {
+    while (ts->num_pending > 1) {
+        int k = ts->num_pending - 2;
+        if (k > 0 && ts->pending[k - 1].len < ts->pending[k + 1].len)
+            k--;
+        merge_at(ts, k);
+    }
+}
+
+/**
+ * @brief Sorts an array of n elements using TimSort.
+ *
+ * Falls back to heap_sort_bottom_up() if the scratch buffer cannot be allocated.
+ *
+ * @param arr The array to be sorted.
+ * @param n The number of elements in the array.
+ */
+void tim_sort(int *arr, int n) {
+    if (n < 2) {
+        return;
+    }
+    if (n < TIM_SORT_MIN_MERGE) {
+        binary_insertion_sort(arr, n, count_run_and_make_ascending(arr, n));
+        return;
+    }
+
+    tim_state_t ts;
+    ts.tmp = malloc((n / 2 + 1) * sizeof(int));
+    if (ts.tmp == NULL) {
+        heap_sort_bottom_up(arr, n);
+        return;
+    }
+    ts.min_gallop = TIM_SORT_MIN_GALLOP;
+    ts.num_pending = 0;
+
+    int min_run = compute_min_run(n);
+    int *lo = arr;
+    int remaining = n;
+    do {
+        // Find the next run, extending it to min_run if it is short
+        int run_len = count_run_and_make_ascending(lo, remaining);
+        if (run_len < min_run) {
+            int force = remaining < min_run ? remaining : min_run;
+            binary_insertion_sort(lo, force, run_len);
+            run_len = force;
+        }
+
+        ts.pending[ts.num_pending].base = lo;
+        ts.pending[ts.num_pending].len = run_len;
+        ts.num_pending++;
+        merge_collapse(&ts);
+
+        lo += run_len;
+        remaining -= run_len;
+    } while (remaining != 0);
+
+    merge_force_collapse(&ts);
+    free(ts.tmp);
+}
+
+#ifdef SORT_DEMO
+/**
+ * @brief Checks that an array is sorted in non-decreasing order.
+ *
+ * @param arr The array to check.
+ * @param n The size of the array.
+ */
+static void assert_sorted(const int *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        assert(arr[i - 1] <= arr[i]);
+    }
+}
+
+/**
+ * @brief Driver code to demonstrate the tim_sort function.
+ *
+ * Covers small inputs, nearly sorted inputs made of long runs, and random input.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    int arr1[] = {64, 34, 25, 12, 22, 11, 90, 5};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+    tim_sort(arr1, n1);
+    sort_print_array(arr1, n1);
+    int expected1[] = {5, 11, 12, 22, 25, 34, 64, 90};
+    for (int i = 0; i < n1; i++) {
+        assert(arr1[i] == expected1[i]);
+    }
+
+    enum { N = 200000 };
+    static int big[N];
+
+    for (int i = 0; i < N; i++) big[i] = i;             // Sorted
+    tim_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = N - i;         // Reverse sorted
+    tim_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i % 1000;      // Sawtooth: 200 ascending runs
+    tim_sort(big, N);
+    assert_sorted(big, N);
+
+    for (int i = 0; i < N; i++) big[i] = i;             // Sorted with random appends
+    srand(9);
+    for (int i = N - 100; i < N; i++) big[i] = rand() % N;
+    tim_sort(big, N);
+    assert_sorted(big, N);
+
+    long long sum_before = 0, sum_after = 0;
+    for (int i = 0; i < N; i++) {                       // Random with duplicates
+        big[i] = rand() % 5000 - 2500;
+        sum_before += big[i];
+    }
+    tim_sort(big, N);
+    assert_sorted(big, N);
+    for (int i = 0; i < N; i++) sum_after += big[i];
+    assert(sum_before == sum_after);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
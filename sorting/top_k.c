@@ -0,0 +1,311 @@
+/**
+ * @file top_k.c
+ * @brief Implementation of streaming top-k selection with a bounded min-heap.
+ *
+ * @details
+ * Sorting a whole array to read off its k largest values costs O(n log n) time and needs the
+ * whole array at once. A top_k_t instead keeps the k largest values seen so far in a min-heap
+ * of size k, whose root is the smallest of them:
+ * - **Filtering**: a new value that is not larger than the root cannot be in the result, and
+ *   once the stream is long that is nearly every value. The scan over a chunk is then a
+ *   single comparison per value against a root held in a register.
+ * - **Replacement**: a value that does get in replaces the root and is placed with Floyd's
+ *   bottom-up sift, the same code heap_sort_bottom_up.c uses (SORT_DEFINE_INT_HEAP_() in
+ *   sort_internal.h). A newcomer is usually among the smallest of the kept values, so moving
+ *   the hole to a leaf first and sifting up from there saves comparisons.
+ * - **Merging**: the kept values of one accumulator are simply streamed into another, so
+ *   per-thread accumulators combine in O(k log k). top_k_largest() splits an array into one
+ *   chunk per thread on the pool from sort_pool.c and merges the partial results.
+ *
+ * @section Performance
+ * - Time Complexity: O(n + m log k) for a stream of n values of which m enter the heap; for a
+ *   random order, m is about k ln(n / k).
+ * - Space Complexity: O(k), or O(p * k) for top_k_largest() on p threads.
+ *
+ * Author: Kiran Jojare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "sort_internal.h"
+#include "sort_pool.h"
+#include "top_k.h"
+
+/** Arrays of at least this size are scanned by all threads together. */
+#define TOP_K_PARALLEL_MIN (1 << 16)
+/** Upper bound on the number of chunks. */
+#define TOP_K_MAX_CHUNKS 64
+
+struct top_k {
+    int k;
+    int size;
+    int *heap; /**< Min-heap of the kept values. */
+};
+
+/**
+ * @brief Arguments of one chunk of top_k_largest().
+ */
+typedef struct {
+    const int *arr;
+    int n;
+    top_k_t *tk;
+} top_k_job_t;
+
+// A min-heap: smaller values belong above larger ones
+SORT_DEFINE_INT_HEAP_(min_heap, SORT_LESS)
+
+top_k_t *top_k_create(int k) {
+    if (k < 1) {
+        return NULL;
+    }
+    top_k_t *tk = malloc(sizeof(*tk));
+    if (tk == NULL) {
+        return NULL;
+    }
+    tk->heap = malloc(k * sizeof(int));
+    if (tk->heap == NULL) {
+        free(tk);
+        return NULL;
+    }
+    tk->k = k;
+    tk->size = 0;
+    return tk;
+}
+
+void top_k_destroy(top_k_t *tk) {
+    if (tk != NULL) {
+        free(tk->heap);
+        free(tk);
+    }
+}
+
+void top_k_reset(top_k_t *tk) {
+    tk->size = 0;
+}
+
+int top_k_push(top_k_t *tk, const int *values, int n) {
+    if (tk == NULL || n < 0 || (values == NULL && n > 0)) {
+        return -1;
+    }
+
+    int i = 0;
+    while (tk->size < tk->k && i < n) {
+        min_heap_sift_up(tk->heap, 0, tk->size, values[i], 2);
+        tk->size++;
+        i++;
+    }
+    if (i == n) {
+        return 0;
+    }
+
+    // The heap is full: only values above its minimum get in
+    int *heap = tk->heap;
+    int k = tk->k;
+    int min = heap[0];
+    for (; i < n; i++) {
+        if (values[i] > min) {
+            min_heap_sift_bottom_up(heap, k, 0, values[i], 2);
+            min = heap[0];
+        }
+    }
+    return 0;
+}
+
+int top_k_merge(top_k_t *dst, const top_k_t *src) {
+    if (src == NULL) {
+        return -1;
+    }
+    if (dst != src || src->size == 0) {
+        return top_k_push(dst, src->heap, src->size);
+    }
+    // Pushing a heap into itself would sift over values not read yet, so copy them first
+    int *copy = malloc((size_t)src->size * sizeof(int));
+    if (copy == NULL) {
+        return -1;
+    }
+    memcpy(copy, src->heap, (size_t)src->size * sizeof(int));
+    int status = top_k_push(dst, copy, src->size);
+    free(copy);
+    return status;
+}
+
+int top_k_count(const top_k_t *tk) {
+    return tk->size;
+}
+
+int top_k_result(const top_k_t *tk, int *out) {
+    memcpy(out, tk->heap, tk->size * sizeof(int));
+    intro_sort(out, tk->size);
+    for (int i = 0, j = tk->size - 1; i < j; i++, j--) {
+        int temp = out[i];
+        out[i] = out[j];
+        out[j] = temp;
+    }
+    return tk->size;
+}
+
+/**
+ * @brief Task body: streams one chunk into its own accumulator.
+ */
+static void chunk_top_k(void *arg) {
+    const top_k_job_t *job = arg;
+
+    top_k_push(job->tk, job->arr, job->n);
+}
+
+int top_k_largest(const int *arr, int n, int k, int *out) {
+    if (n < 0 || k < 1 || (arr == NULL && n > 0) || out == NULL) {
+        return -1;
+    }
+
+    sort_pool_t *pool = NULL;
+    int chunks = 1;
+    if (n >= TOP_K_PARALLEL_MIN) {
+        pool = sort_pool_default();
+        chunks = sort_pool_threads(pool);
+        if (chunks > TOP_K_MAX_CHUNKS)
+            chunks = TOP_K_MAX_CHUNKS;
+    }
+
+    top_k_job_t job[TOP_K_MAX_CHUNKS];
+    sort_task_t task[TOP_K_MAX_CHUNKS];
+    int created = 0;
+    for (; created < chunks; created++) {
+        int begin = (int)((long long)n * created / chunks);
+        int end = (int)((long long)n * (created + 1) / chunks);
+        job[created].arr = arr + begin;
+        job[created].n = end - begin;
+        job[created].tk = top_k_create(k);
+        if (job[created].tk == NULL)
+            break;
+    }
+
+    int count = -1;
+    if (created == chunks) {
+        for (int c = 1; c < chunks; c++) {
+            sort_pool_spawn(pool, &task[c], chunk_top_k, &job[c]);
+        }
+        chunk_top_k(&job[0]);
+        for (int c = chunks - 1; c >= 1; c--) {
+            sort_pool_wait(pool, &task[c]);
+            top_k_merge(job[0].tk, job[c].tk);
+        }
+        count = top_k_result(job[0].tk, out);
+    }
+    for (int c = 0; c < created; c++) {
+        top_k_destroy(job[c].tk);
+    }
+    return count;
+}
+
+#ifdef SORT_DEMO
+static int compare_desc(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x < y) - (x > y);
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Driver code to demonstrate streaming top-k.
+ *
+ * Streams a large array in uneven chunks, merges per-part accumulators, runs
+ * top_k_largest() on four threads (unless SORT_THREADS is already set) and checks all of
+ * them against a full sort, whose time is printed next to the streaming one.
+ *
+ * @return 0 on successful execution.
+ */
+int main() {
+    setenv("SORT_THREADS", "4", 0);
+
+    int arr1[] = {1, 23, 12, 9, 30, 2, 50};
+    int top1[3];
+    assert(top_k_largest(arr1, 7, 3, top1) == 3);
+    sort_print_array(top1, 3);
+    assert(top1[0] == 50 && top1[1] == 30 && top1[2] == 23);
+
+    // Fewer values than k, duplicates and extreme values
+    int arr2[] = {INT_MIN, 5, 5, INT_MAX};
+    int top2[10];
+    assert(top_k_largest(arr2, 4, 10, top2) == 4);
+    assert(top2[0] == INT_MAX && top2[1] == 5 && top2[2] == 5 && top2[3] == INT_MIN);
+    assert(top_k_largest(arr2, 4, 0, top2) == -1);
+    assert(top_k_create(0) == NULL);
+
+    // Merging an accumulator into itself counts every kept value twice
+    int arr3[] = {5, 1, 9, 3};
+    int top3[8];
+    top_k_t *self = top_k_create(8);
+    assert(self != NULL);
+    assert(top_k_push(self, arr3, 4) == 0);
+    assert(top_k_merge(self, self) == 0);
+    assert(top_k_result(self, top3) == 8);
+    sort_print_array(top3, 8);
+    const int self_expected[] = {9, 9, 5, 5, 3, 3, 1, 1};
+    assert(memcmp(top3, self_expected, sizeof(self_expected)) == 0);
+    top_k_destroy(self);
+
+    enum { N = 2000000, K = 100, PARTS = 4 };
+    int *big = malloc(N * sizeof(int));
+    int *sorted = malloc(N * sizeof(int));
+    assert(big != NULL && sorted != NULL);
+    srand(59);
+    for (int i = 0; i < N; i++) {
+        big[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand()) % 1000000;
+    }
+    memcpy(sorted, big, N * sizeof(int));
+    clock_t start = clock();
+    qsort(sorted, N, sizeof(int), compare_desc);
+    double t_sort = seconds_since(start);
+
+    // One accumulator fed in uneven chunks
+    int result[K];
+    top_k_t *tk = top_k_create(K);
+    assert(tk != NULL);
+    start = clock();
+    for (int i = 0, chunk = 1; i < N; i += chunk, chunk = chunk * 3 % 10007 + 1) {
+        int len = N - i < chunk ? N - i : chunk;
+        assert(top_k_push(tk, big + i, len) == 0);
+    }
+    double t_stream = seconds_since(start);
+    assert(top_k_result(tk, result) == K);
+    assert(memcmp(result, sorted, K * sizeof(int)) == 0);
+
+    // Partial results of separate streams, merged
+    top_k_t *part[PARTS];
+    top_k_reset(tk);
+    for (int p = 0; p < PARTS; p++) {
+        part[p] = top_k_create(p == 0 ? K : 2 * K);
+        assert(part[p] != NULL);
+        assert(top_k_push(part[p], big + (long long)N * p / PARTS, N / PARTS) == 0);
+        assert(top_k_merge(tk, part[p]) == 0);
+    }
+    assert(top_k_count(tk) == K);
+    assert(top_k_result(tk, result) == K);
+    assert(memcmp(result, sorted, K * sizeof(int)) == 0);
+    for (int p = 0; p < PARTS; p++) {
+        top_k_destroy(part[p]);
+    }
+    top_k_destroy(tk);
+
+    assert(top_k_largest(big, N, K, result) == K);
+    assert(memcmp(result, sorted, K * sizeof(int)) == 0);
+    printf("Top %d of %d ints: streaming %.3fs, full sort %.3fs\n", K, N, t_stream, t_sort);
+    free(big);
+    free(sorted);
+
+    printf("All test cases passed successfully.\n");
+
+    return 0;
+}
+#endif /* SORT_DEMO */
@@ -0,0 +1,87 @@
+/**
+ * @file top_k.h
+ * @brief Streaming selection of the k largest ints.
+ *
+ * @details
+ * A top_k_t consumes values in chunks of any size and remembers only the k largest seen so
+ * far, so a stream can be processed without storing or sorting it. Accumulators filled
+ * separately (for instance one per thread) combine with top_k_merge(), and
+ * top_k_largest() does exactly that for one array on the thread pool.
+ *
+ * @section Example Usage
+ * @code
+ * top_k_t *tk = top_k_create(10);
+ * while ((n = read_events(buf, BUF_LEN)) > 0)
+ *     top_k_push(tk, buf, n);
+ * int best[10];
+ * int count = top_k_result(tk, best); // largest first
+ * top_k_destroy(tk);
+ * @endcode
+ */
+
+#ifndef TOP_K_H
+#define TOP_K_H
+
+typedef struct top_k top_k_t;
+
+/**
+ * @brief Creates an empty accumulator for the k largest values.
+ *
+ * @return The accumulator, or NULL if k < 1 or memory cannot be allocated.
+ */
+top_k_t *top_k_create(int k);
+
+/**
+ * @brief Frees an accumulator.
+ *
+ * @param tk The accumulator, may be NULL.
+ */
+void top_k_destroy(top_k_t *tk);
+
+/**
+ * @brief Forgets every value seen so far.
+ */
+void top_k_reset(top_k_t *tk);
+
+/**
+ * @brief Consumes the next n values of the stream.
+ *
+ * @return 0 on success, -1 if the arguments are invalid.
+ */
+int top_k_push(top_k_t *tk, const int *values, int n);
+
+/**
+ * @brief Adds the values kept by src to dst, as if dst had also seen src's stream.
+ *
+ * src may have a different k; only dst's k values are kept. dst and src may be the same
+ * accumulator, in which case every kept value is counted twice; the values are copied to a
+ * temporary buffer first.
+ *
+ * @return 0 on success, -1 if the arguments are invalid or the temporary buffer cannot be
+ *         allocated.
+ */
+int top_k_merge(top_k_t *dst, const top_k_t *src);
+
+/**
+ * @brief Returns the number of values kept: k, or fewer if fewer were seen.
+ */
+int top_k_count(const top_k_t *tk);
+
+/**
+ * @brief Writes the kept values to out, largest first, without changing the accumulator.
+ *
+ * @param out Room for top_k_count(tk) values.
+ * @return The number of values written.
+ */
+int top_k_result(const top_k_t *tk, int *out);
+
+/**
+ * @brief Finds the k largest values of an array, in parallel for large arrays.
+ *
+ * @param out Room for k values; receives min(k, n) values, largest first.
+ * @return The number of values written, or -1 if the arguments are invalid or memory cannot
+ *         be allocated.
+ */
+int top_k_largest(const int *arr, int n, int k, int *out);
+
+#endif /* TOP_K_H */